@@ -0,0 +1,60 @@
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "tile_node.hpp"
+#include "tabulation.hpp"
+#include "closed_open_address.hpp"
+#include "closed_swiss.hpp"
+#include "closed_robin_hood.hpp"
+
+// Probe cost of linear probing comparing whole nodes through a pointer per
+// slot (ClosedOpenAddress), of probing groups of tags (ClosedSwiss) and of
+// probing entries ordered by displacement (ClosedRobinHood), inserting nodes
+// already in the closed list at a load factor of range(0) percent
+
+using Node = Tiles::TileNode<4, 4>;
+using HashFunction = TabulationHash<Node, 16>;
+size_t const N_ENTRIES = 1 << 20;
+
+// distinct random boards
+static std::vector<Node> getRandomNodes(size_t n_nodes) {
+    std::mt19937 g(0);
+    std::array<uint8_t, 16> board;
+    std::iota(board.begin(), board.end(), 0);
+    std::vector<Node> nodes;
+    for (size_t i = 0; i < n_nodes; ++i) {
+        std::shuffle(board.begin(), board.end(), g);
+        nodes.emplace_back(board);
+    }
+    return nodes;
+}
+
+template <typename Closed>
+static void BM_ClosedInsertDuplicates(benchmark::State& state) {
+    auto nodes = getRandomNodes(N_ENTRIES * state.range(0) / 100);
+    Closed closed(N_ENTRIES);
+    for (auto const & node : nodes) {
+        closed.insert(node);
+    }
+    for (auto _ : state) {
+        for (auto const & node : nodes) {
+            benchmark::DoNotOptimize(closed.insert(node));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+
+BENCHMARK_TEMPLATE(BM_ClosedInsertDuplicates,
+                   ClosedOpenAddress<Node, HashFunction, N_ENTRIES>)
+    ->Arg(50)->Arg(70)->Arg(90);
+BENCHMARK_TEMPLATE(BM_ClosedInsertDuplicates,
+                   ClosedSwiss<Node, HashFunction, N_ENTRIES>)
+    ->Arg(50)->Arg(70)->Arg(90);
+BENCHMARK_TEMPLATE(BM_ClosedInsertDuplicates,
+                   ClosedRobinHood<Node, HashFunction, N_ENTRIES>)
+    ->Arg(50)->Arg(70)->Arg(90);
+
+BENCHMARK_MAIN();
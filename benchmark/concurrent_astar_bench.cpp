@@ -0,0 +1,113 @@
+#include <array>
+#include <random>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "packed_tile_node.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "zobrist.hpp"
+#include "concurrent_open_array.hpp"
+#include "concurrent_astar.hpp"
+#include "random_walk.hpp"
+
+// Throughput of pushing children into the concurrent open list one at a time
+// (batch size 1) and in batches of range(0) nodes per destination bucket
+// under a single lock, with range(1) threads: pushes into the open list alone,
+// and generated nodes of concurrent A* search of a random walk
+
+using Node = Tiles::PackedTileNode<4, 4>;
+using Heuristic = Tiles::ManhattanDistanceHeuristic<4, 4>;
+using HashFunction = ZobristHash<Node>;
+using Open = ConcurrentOpenArray<Node, 100, HashFunction>;
+size_t const N_NODES = 1 << 18;
+size_t const ClosedEntries = 1 << 22;
+
+// children of random walks from goal
+static std::vector<Node> getRandomChildren(size_t n_nodes) {
+    std::mt19937 g(0);
+    std::uniform_int_distribution<int> dist(0, Tiles::N_MOVES - 1);
+    Heuristic heuristic;
+    auto node = Node::goal_node;
+    evalH(node, heuristic);
+    std::vector<Node> nodes;
+    while (nodes.size() < n_nodes) {
+        auto child_node = node;
+        if (!applyMove(child_node, static_cast<Tiles::MOVE>(dist(g)))) continue;
+        evalChild(node, child_node, heuristic);
+        if (getF(child_node) >= 100) {
+            node = Node::goal_node;
+            evalH(node, heuristic);
+            continue;
+        }
+        nodes.push_back(child_node);
+        node = child_node;
+    }
+    return nodes;
+}
+
+static void BM_ConcurrentOpenArrayPush(benchmark::State& state) {
+    auto batch_size = static_cast<size_t>(state.range(0));
+    auto n_threads = static_cast<int>(state.range(1));
+    auto const nodes = getRandomChildren(N_NODES);
+    Open open(n_threads);
+
+    // thread_id pushes every n_threads-th node
+    auto pushNodes = [&](int thread_id) {
+        std::vector<std::vector<Node>> outboxes(n_threads);
+        for (size_t i = thread_id; i < nodes.size(); i += n_threads) {
+            if (batch_size == 1) {
+                open.push(nodes[i]);
+                continue;
+            }
+            auto dest = open.owner(nodes[i]);
+            outboxes[dest].push_back(nodes[i]);
+            if (outboxes[dest].size() >= batch_size) {
+                open.push(dest, outboxes[dest]);
+            }
+        }
+        for (int dest = 0; dest < n_threads; ++dest) {
+            open.push(dest, outboxes[dest]);
+        }
+    };
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < n_threads; ++i) {
+            threads.emplace_back(pushNodes, i);
+        }
+        for (auto & t : threads) {
+            t.join();
+        }
+        state.PauseTiming();
+        for (int i = 0; i < n_threads; ++i) {
+            while (open.pop(i).has_value());
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+
+BENCHMARK(BM_ConcurrentOpenArrayPush)
+    ->ArgsProduct({{1, 4, 16, 64, 256}, {1, 2, 4}})
+    ->UseRealTime();
+
+static void BM_ConcurrentAStarSearch(benchmark::State& state) {
+    auto batch_size = static_cast<size_t>(state.range(0));
+    auto n_threads = static_cast<int>(state.range(1));
+    auto const initial_node = randomInitialNode<Node>(40, 1);
+    size_t generated = 0;
+    for (auto _ : state) {
+        ConcurrentAStar<Node, Heuristic, HashFunction, ClosedEntries>
+            search(Heuristic(), n_threads, ClosedEntries, false, batch_size);
+        benchmark::DoNotOptimize(search.search(initial_node));
+        generated += search.generated();
+    }
+    state.SetItemsProcessed(generated);
+}
+
+BENCHMARK(BM_ConcurrentAStarSearch)
+    ->ArgsProduct({{1, 4, 16, 64, 256}, {1, 2, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -6,7 +6,8 @@
 #include "manhattan_distance_heuristic.hpp"
 
 // Difference between manhattan distance heuristic and incremental manhattan
-// distance heuristic
+// distance heuristic, and evaluation of children of a random walk from scratch
+// (evalH) and from their parent (evalChild)
 
 using Heuristic = Tiles::ManhattanDistanceHeuristic<4, 4>;
 using Node = Tiles::TileNode<4, 4>;
@@ -46,4 +47,30 @@ static void BM_IncrementalManhattanDistanceHeuristic(benchmark::State& state) {
 
 BENCHMARK(BM_IncrementalManhattanDistanceHeuristic)->Range(8, 8<<10);
 
+template <bool FROM_PARENT>
+static void BM_ManhattanDistanceRandomWalk(benchmark::State& state) {
+    std::mt19937 g(0);
+    std::uniform_int_distribution<int> dist(0, Tiles::N_MOVES - 1);
+    Heuristic heuristic;
+    auto node = Node::goal_node;
+    evalH(node, heuristic);
+    for (auto _ : state) {
+        for (int i = 0, i_end = state.range(0); i < i_end; ++i) {
+            auto child_node = node.moveBlank(static_cast<Tiles::MOVE>(dist(g)));
+            if (child_node.has_value()) {
+                if (FROM_PARENT) {
+                    evalChild(node, *child_node, heuristic);
+                } else {
+                    evalH(*child_node, heuristic);
+                }
+                node = *child_node;
+            }
+        }
+        benchmark::DoNotOptimize(node);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ManhattanDistanceRandomWalk, false)->Range(8, 8<<10);
+BENCHMARK_TEMPLATE(BM_ManhattanDistanceRandomWalk, true)->Range(8, 8<<10);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,51 @@
+#include <random>
+#include <benchmark/benchmark.h>
+#include "packed_tile_node.hpp"
+#include "pattern_database_heuristic.hpp"
+
+// Lookup cost of pattern database storage policies versus table footprint:
+// one byte per entry, 4 bits per entry and 2 bits per entry (mod 3, children
+// evaluated incrementally from parent), on a random walk of the 15 puzzle
+
+using Node = Tiles::PackedTileNode<4, 4>;
+
+template <typename Storage>
+using Heuristic = Tiles::PatternDatabaseHeuristic<4, 4, Storage>;
+
+// 5-5-5 partition, small enough to build quickly
+template <typename Storage>
+Heuristic<Storage> const & getHeuristic() {
+    static Heuristic<Storage> heuristic(
+        Tiles::Partition{{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15}});
+    return heuristic;
+}
+
+template <typename Storage>
+static void BM_PatternDatabaseHeuristic(benchmark::State& state) {
+    auto const & heuristic = getHeuristic<Storage>();
+    std::mt19937 g(0);
+    std::uniform_int_distribution<int> dist(0, Tiles::N_MOVES - 1);
+    auto node = Node::goal_node;
+    evalH(node, heuristic);
+    for (auto _ : state) {
+        for (int i = 0, i_end = state.range(0); i < i_end; ++i) {
+            auto child_node = node.moveBlank(static_cast<Tiles::MOVE>(dist(g)));
+            if (child_node.has_value()) {
+                evalChild(node, *child_node, heuristic);
+                node = *child_node;
+            }
+        }
+        benchmark::DoNotOptimize(node);
+    }
+    size_t table_bytes = 0;
+    for (auto const & database : heuristic.databases) {
+        table_bytes += database.table_size;
+    }
+    state.counters["table_bytes"] = table_bytes;
+}
+
+BENCHMARK_TEMPLATE(BM_PatternDatabaseHeuristic, Tiles::ByteStorage)->Range(8, 8<<10);
+BENCHMARK_TEMPLATE(BM_PatternDatabaseHeuristic, Tiles::NibbleStorage)->Range(8, 8<<10);
+BENCHMARK_TEMPLATE(BM_PatternDatabaseHeuristic, Tiles::Mod3Storage)->Range(8, 8<<10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+# run 15 puzzle instances with increasing thread counts, report the machine
+# (cores, CPU model), then solve time and speedup over one thread for each
+# instance
+
+import argparse
+import os
+import platform
+import subprocess
+
+FIFTEEN_PUZZLE_FOLDER = "./Korf100/"
+SOLVER = "../build/src/ConcurrentSolver"
+
+if os.path.basename(os.getcwd()) != "script":
+    print("Script is running in the wrong folder!")
+    exit()
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-s", "--search_algorithm", default="concurrent_astar",
+                    help="concurrent_astar or parallel_idastar")
+parser.add_argument("-t", "--threads", default="1,2,4,8,16,32,64",
+                    help="comma separated thread counts")
+parser.add_argument("-p", "--problems", default="prob001,prob002,prob003",
+                    help="comma separated Korf100 instances")
+parser.add_argument("-m", "--memory_budget", default=None,
+                    help="closed list memory in MB, passed to the solver")
+args = parser.parse_args()
+
+thread_counts = [int(t) for t in args.threads.split(",")]
+
+
+# milliseconds to solve, excluding initialization
+def solve(initial_state, n_threads):
+    command = [SOLVER, "-s", args.search_algorithm,
+               "-t", str(n_threads), "-i", initial_state]
+    if args.memory_budget is not None:
+        command += ["--memory_budget", args.memory_budget]
+    output = subprocess.run(command, stdout=subprocess.PIPE,
+                            universal_newlines=True, check=True).stdout
+    lines = output.splitlines()
+    initialize_timing = int(lines[0].split()[0])
+    timing = int(next(line for line in lines
+                      if "ms to solve" in line).split()[0])
+    return timing - initialize_timing
+
+
+# CPU model from /proc/cpuinfo, otherwise as reported by platform
+def cpu_model():
+    try:
+        with open("/proc/cpuinfo") as cpuinfo:
+            for line in cpuinfo:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor() or "unknown"
+
+
+print("machine:", os.cpu_count(), "cores,", cpu_model())
+print("search algorithm:", args.search_algorithm)
+print("problem", *("t=" + str(t) for t in thread_counts), sep="\t")
+total_times = [0] * len(thread_counts)
+for filename in args.problems.split(","):
+    file = open(os.path.join(FIFTEEN_PUZZLE_FOLDER, filename))
+    initial_state = file.readlines()[1].strip()  # read initial state
+
+    times = [solve(initial_state, t) for t in thread_counts]
+    total_times = [total + time for total, time in zip(total_times, times)]
+    print(filename, *("%d ms (%.2fx)" % (time, times[0] / max(time, 1))
+                      for time in times), sep="\t")
+
+print("total", *("%d ms (%.2fx)" % (time, total_times[0] / max(time, 1))
+                 for time in total_times), sep="\t")
@@ -4,12 +4,15 @@
 #include <memory>
 #include <optional>
 #include <vector>
-#include <forward_list>
+#include <deque>
 #include <algorithm>
 #include <ostream>
+#include "lazy_array.hpp"
 
 /* Closed list using chained hash table
- * Nodes are allocated individually via a link list
+ * Nodes are allocated in a deque of links (stable addresses), buckets hold
+ * the first link of their list. N_Entries is the default number of buckets,
+ * allocated lazily (see LazyArray).
  */
 
 template <typename Node, typename HashFunction, size_t N_Entries>
@@ -17,9 +20,22 @@ struct ClosedChaining {
 
     static const HashFunction hasher;
 
-    std::vector<std::forward_list<Node> > closed;
+    struct Link {
+        Node node;
+        Link * next;
+    };
+
+    size_t n_entries;
+
+    LazyArray<Link *> closed;
+
+    std::deque<Link> links;
+
+    // memory of a bucket and a stored node
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(Link *) + sizeof(Link);
     
-    ClosedChaining() : closed(N_Entries) {}
+    explicit ClosedChaining(size_t n_entries = N_Entries)
+        : n_entries(n_entries), closed(n_entries) {}
 
     // returns true if node needs to be expanded,
     // insert node if not already exist in closed, or if lower f-val than
@@ -42,16 +58,16 @@ ClosedChaining<Node, HashFunction, N_Entries>::hasher = HashFunction();
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 bool ClosedChaining<Node, HashFunction, N_Entries>::insert(Node const & node) {
-    size_t idx = hasher(node) % N_Entries;
+    size_t idx = hasher(node) % n_entries;
 
     auto & bucket = closed[idx];
     
     ++probe_count;
     
-    for (auto it = bucket.begin(); it != bucket.end(); ++it) {
-        if (*it == node) { // found
-            if (getF(node) < getF(*it)) { // reopening
-                *it = node;
+    for (auto link = bucket; link != nullptr; link = link->next) {
+        if (link->node == node) { // found
+            if (getF(node) < getF(link->node)) { // reopening
+                link->node = node;
                 return true;
             }
             return false;
@@ -60,7 +76,8 @@ bool ClosedChaining<Node, HashFunction, N_Entries>::insert(Node const & node) {
     }
     
     // not found
-    bucket.push_front(node); // insert at front of linked list
+    links.push_back(Link{node, bucket});
+    bucket = &links.back(); // insert at front of linked list
     ++size;
     return true;
 }
@@ -70,17 +87,18 @@ std::vector<Node>
 ClosedChaining<Node, HashFunction, N_Entries>::getPath(Node const & node) const {
     std::vector<Node> path;
     std::optional<Node> to_find = node;
-    size_t idx = hasher(*to_find) % N_Entries;
+    size_t idx = hasher(*to_find) % n_entries;
 
     while (to_find.has_value()) {
-        auto & bucket = closed[idx];
-
-        auto it = std::find(bucket.begin(), bucket.end(), to_find.value());
+        auto link = closed[idx];
+        while (link != nullptr && !(link->node == to_find.value())) {
+            link = link->next;
+        }
 
-        if (it != bucket.end()) { // found
-            path.push_back(*it);
-            to_find = getParent(*it);
-            if (to_find.has_value()) idx = hasher(to_find.value()) % N_Entries;
+        if (link != nullptr) { // found
+            path.push_back(link->node);
+            to_find = getParent(link->node);
+            if (to_find.has_value()) idx = hasher(to_find.value()) % n_entries;
         }
     }
 
@@ -92,7 +110,7 @@ template <typename Node, typename HashFunction, size_t N_Entries>
 std::ostream &operator<<(std::ostream& os,
                          ClosedChaining<Node, HashFunction, N_Entries> const & closed) {
     os <<  "closed list load factor: "
-       << (double)(closed.size) / N_Entries << "\n"
+       << (double)(closed.size) / closed.n_entries << "\n"
        << "closed list probes: " << closed.probe_count << "\n";
     return os;
 }
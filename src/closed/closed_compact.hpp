@@ -0,0 +1,95 @@
+#ifndef CLOSED_COMPACT_HPP
+#define CLOSED_COMPACT_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <ostream>
+#include "lazy_array.hpp"
+
+/* Closed list using open addressing hash table with linear probing, storing
+ * only the key of each node (e.g. its packed board) and its g value, for
+ * searches that only need the cost of the solution. Requires a free
+ * function getKey(node) returning an integer that identifies the state of
+ * node and is never zero. Parents are not stored, so getPath only returns
+ * the given node, whose g value is the solution cost.
+ * The h value of a state does not depend on the path to it, so reopening
+ * compares g values instead of f values.
+ * N_Entries is the default number of entries, allocated lazily (see
+ * LazyArray), entries are valid (empty) when zero
+ */
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+struct ClosedCompact {
+    using Key = decltype(getKey(std::declval<Node const &>()));
+
+    static const HashFunction hasher;
+
+    size_t n_entries;
+
+    LazyArray<Key> keys;
+    LazyArray<uint8_t> g_vals;
+
+    // memory of an entry
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(Key) + sizeof(uint8_t);
+
+    explicit ClosedCompact(size_t n_entries = N_Entries)
+        : n_entries(n_entries), keys(n_entries), g_vals(n_entries) {}
+
+    // returns true if node needs to be expanded,
+    // insert node if not already exist in closed, or if lower g-val than
+    // existing closed node (reopening), throws std::length_error if the
+    // closed list is full
+    bool insert(Node const & node);
+
+    // path is not stored, returns node, assumes node is in the closed list
+    std::vector<Node> getPath(Node const & node) const;
+
+    size_t size = 0; // number of nodes in closed list
+};
+
+template<typename Node, typename HashFunction, size_t N_Entries>
+const HashFunction
+ClosedCompact<Node, HashFunction, N_Entries>::hasher = HashFunction();
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+bool ClosedCompact<Node, HashFunction, N_Entries>::insert(Node const & node) {
+    auto const key = getKey(node);
+    auto const g_val = static_cast<uint8_t>(getG(node));
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries; ++i) {
+        if (keys[idx] == 0) { // not found
+            keys[idx] = key; // insert
+            g_vals[idx] = g_val;
+            ++size;
+            return true;
+        } else if (keys[idx] == key) { // found
+            if (g_val < g_vals[idx]) { // reopening
+                g_vals[idx] = g_val;
+                return true;
+            }
+            return false;
+        } else { // collision
+            ++idx;
+            if (idx == n_entries) idx = 0; //wrap around
+        }
+    }
+    throw std::length_error("closed list is full");
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::vector<Node>
+ClosedCompact<Node, HashFunction, N_Entries>::getPath(Node const & node) const {
+    return {node};
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::ostream &operator<<
+(std::ostream& os, ClosedCompact<Node, HashFunction, N_Entries> const & closed) {
+    os <<  "closed list load factor: "
+       << (double)(closed.size) / closed.n_entries << "\n";
+    return os;
+}
+
+#endif
@@ -2,61 +2,88 @@
 #define CLOSED_OPEN_ADDRESS_HPP
 
 #include <vector>
+#include <deque>
 #include <optional>
 #include <algorithm>
 #include <ostream>
+#include <stdexcept>
+#include "lazy_array.hpp"
 
 /* Closed list using open addressing hash table with linear probing
+ * Nodes are stored in a deque (stable addresses), slots hold a pointer to
+ * their node. N_Entries is the default number of slots, allocated lazily
+ * (see LazyArray), slots are empty when null.
  */
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 struct ClosedOpenAddress {
-    static const Node NullEntry;
-
     static const HashFunction hasher;
 
-    std::vector<Node> closed;
+    size_t n_entries;
+
+    LazyArray<Node *> closed;
+
+    std::deque<Node> nodes;
+
+    // memory of a slot and a stored node
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(Node *) + sizeof(Node);
 
-    ClosedOpenAddress() : closed(N_Entries, Node()) {}
+    explicit ClosedOpenAddress(size_t n_entries = N_Entries)
+        : n_entries(n_entries), closed(n_entries) {}
 
     // returns true if node needs to be expanded,
     // insert node if not already exist in closed, or if lower f-val than
-    // existing closed node (reopening)
+    // existing closed node (reopening), throws std::length_error if the
+    // closed list is full
     bool insert(Node const & node);
 
     // given node, return path in closed list by tracing parent nodes
     // assumes node is in the closed list; otherwise returns empty path
     std::vector<Node> getPath(Node const & node) const;
 
+    // stored node equal to node, nullptr if not in closed list
+    Node const * find(Node const & node) const;
+
     size_t size = 0; // number of nodes in closed list
 };
 
-template<typename Node, typename HashFunction, size_t N_Entries>
-Node const ClosedOpenAddress<Node, HashFunction, N_Entries>::NullEntry = Node();
-
 template<typename Node, typename HashFunction, size_t N_Entries>
 const HashFunction ClosedOpenAddress<Node, HashFunction, N_Entries>::hasher = HashFunction();
 
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 bool ClosedOpenAddress<Node, HashFunction, N_Entries>::insert(Node const & node) {
-    size_t idx = hasher(node) % N_Entries;
-    while (true) {
-        if (closed[idx] == NullEntry) { // empty slot
-            closed[idx] = node; // insert
+    size_t idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries; ++i) {
+        if (closed[idx] == nullptr) { // empty slot
+            nodes.push_back(node);
+            closed[idx] = &nodes.back(); // insert
             ++size;
             return true;
-        } else if (closed[idx] == node) { // found
-            if (getF(node) < getF(closed[idx])) { // reopening
-                closed[idx] = node;
+        } else if (*closed[idx] == node) { // found
+            if (getF(node) < getF(*closed[idx])) { // reopening
+                *closed[idx] = node;
                 return true;
             }
             return false;
         } else { // collision
             ++idx;
-            if (idx == N_Entries) idx = 0; //wrap around
+            if (idx == n_entries) idx = 0; //wrap around
         }
     }
+    throw std::length_error("closed list is full");
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+Node const *
+ClosedOpenAddress<Node, HashFunction, N_Entries>::find(Node const & node) const {
+    size_t idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries && closed[idx] != nullptr; ++i) {
+        if (*closed[idx] == node) return closed[idx]; // found
+        ++idx;
+        if (idx == n_entries) idx = 0; // wrap around
+    }
+    return nullptr;
 }
 
 template <typename Node, typename HashFunction, size_t N_Entries>
@@ -64,18 +91,12 @@ std::vector<Node>
 ClosedOpenAddress<Node, HashFunction, N_Entries>::getPath(Node const &node) const {
     std::vector<Node> path;
     std::optional<Node> to_find = node;
-    size_t idx = hasher(*to_find) % N_Entries;
 
     while (to_find.has_value()) {
-        if (closed[idx] == to_find.value()) { // found
-            path.push_back(closed[idx]);
-            to_find = getParent(closed[idx]);
-            if (to_find.has_value()) idx = hasher(to_find.value()) % N_Entries;
-        } else {
-            ++idx;
-            if (idx == N_Entries) idx = 0; // wrap around
-            if (closed[idx] == NullEntry) throw;
-        }
+        auto closed_node = find(*to_find);
+        if (closed_node == nullptr) return {}; // not in closed list
+        path.push_back(*closed_node);
+        to_find = getParent(*closed_node);
     }
 
     std::reverse(path.begin(), path.end());
@@ -86,7 +107,7 @@ template <typename Node, typename HashFunction, size_t N_Entries>
 std::ostream &operator<<(std::ostream& os,
                          ClosedOpenAddress<Node, HashFunction, N_Entries> const & closed) {
     os <<  "closed list load factor: "
-       << (double)(closed.size) / N_Entries << "\n";
+       << (double)(closed.size) / closed.n_entries << "\n";
     return os;
 }
 
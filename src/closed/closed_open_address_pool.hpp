@@ -6,33 +6,57 @@
 #include <memory>
 #include <ostream>
 #include <algorithm>
+#include <stdexcept>
 #include "boost/pool/object_pool.hpp"
+#include "lazy_array.hpp"
+#include "pool_entry.hpp"
 
 /* Closed list using open addressing hash table with linear probing
- * stores pointers instead of nodes, requires clients to allocate memory,
- * e.g. using a memory pool
+ * stores pointers instead of nodes, nodes are allocated from a memory pool
+ * together with a pointer to the entry of their parent (see PoolEntry).
+ * The parent entry is found on insert, it is usually the last inserted
+ * entry, as the open list pops children of the last expanded node first,
+ * otherwise it is probed for.
+ * N_Entries is the default number of entries, allocated lazily (see
+ * LazyArray)
  */
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 struct ClosedOpenAddressPool {
+    using Entry = PoolEntry<Node>;
 
-    boost::object_pool<Node> pool{1024};//4096 / sizeof(Node)};
+    boost::object_pool<Entry> pool{1024};//4096 / sizeof(Entry)};
     
     static const HashFunction hasher;
 
-    std::vector<Node *> closed;
+    size_t n_entries;
 
-    ClosedOpenAddressPool() : closed(N_Entries, nullptr) {}
+    LazyArray<Entry *> closed;
+
+    Entry const * last_inserted = nullptr;
+
+    // memory of an entry and a stored node
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(Entry *) + sizeof(Entry);
+
+    explicit ClosedOpenAddressPool(size_t n_entries = N_Entries)
+        : n_entries(n_entries), closed(n_entries) {}
 
     // returns true if node needs to be expanded,
     // insert node if not already exist in closed, or if lower f-val than
-    // existing closed node (reopening)
+    // existing closed node (reopening), throws std::length_error if the
+    // closed list is full
     bool insert(Node node);
 
-    // given node, return path in closed list by tracing parent nodes
+    // given node, return path in closed list by following parent entries
     // assumes node is in the closed list; otherwise returns empty path
     std::vector<Node> getPath(Node const node) const;
 
+    // closed entry of node, nullptr if not in closed list
+    Entry const * find(Node const & node) const;
+
+    // closed entry of parent of node, nullptr if node has no parent
+    Entry const * findParent(Node const & node) const;
+
     size_t size = 0; // number of nodes in closed list
 };
 
@@ -42,55 +66,64 @@ ClosedOpenAddressPool<Node, HashFunction, N_Entries>::hasher = HashFunction();
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 bool ClosedOpenAddressPool<Node, HashFunction, N_Entries>::insert(Node node) {
-    auto idx = hasher(node) % N_Entries;
-    while (true) {
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries; ++i) {
         if (closed[idx] == nullptr) { // not found
-            auto node_ptr = pool.construct(std::move(node));
-            closed[idx] = node_ptr; // insert
+            auto parent = findParent(node);
+            closed[idx] = pool.construct(Entry{std::move(node), parent}); // insert
+            last_inserted = closed[idx];
             ++size;
             return true;
-        } else if (*closed[idx] == node) { // found
-            if (getF(node) < getF(*closed[idx])) { // reopening
-                auto node_ptr = pool.construct(std::move(node));
-                closed[idx] = node_ptr;
+        } else if (closed[idx]->node == node) { // found
+            if (getF(node) < getF(closed[idx]->node)) { // reopening
+                auto parent = findParent(node);
+                closed[idx] = pool.construct(Entry{std::move(node), parent});
+                last_inserted = closed[idx];
                 return true;
             }
             return false;
         } else { // collision
             ++idx;
-            if (idx == N_Entries) idx = 0; //wrap around
+            if (idx == n_entries) idx = 0; //wrap around
         }
     }
+    throw std::length_error("closed list is full");
 }
 
 template <typename Node, typename HashFunction, size_t N_Entries>
-std::vector<Node>
-ClosedOpenAddressPool<Node, HashFunction, N_Entries>::getPath(Node const node) const {
-    std::vector<Node> path;
-    std::optional<Node> to_find = node;
-    auto idx = hasher(*to_find) % N_Entries;
-
-    while (to_find.has_value()) {
-        if (*closed[idx] == to_find) { // found
-            path.push_back(*closed[idx]);
-            to_find = getParent(*closed[idx]);
-            if (to_find.has_value()) idx = hasher(to_find.value()) % N_Entries;
-        } else {
-            ++idx;
-            if (idx == N_Entries) idx = 0; // wrap around
-            if (closed[idx] == nullptr) throw;
-        }
+typename ClosedOpenAddressPool<Node, HashFunction, N_Entries>::Entry const *
+ClosedOpenAddressPool<Node, HashFunction, N_Entries>::find(Node const & node) const {
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries && closed[idx] != nullptr; ++i) {
+        if (closed[idx]->node == node) return closed[idx]; // found
+        ++idx;
+        if (idx == n_entries) idx = 0; // wrap around
     }
+    return nullptr;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+typename ClosedOpenAddressPool<Node, HashFunction, N_Entries>::Entry const *
+ClosedOpenAddressPool<Node, HashFunction, N_Entries>::findParent(Node const & node) const {
+    auto parent = getParent(node);
+    if (!parent.has_value()) return nullptr;
+    if (last_inserted != nullptr && last_inserted->node == *parent) {
+        return last_inserted;
+    }
+    return find(*parent);
+}
 
-    std::reverse(path.begin(), path.end());
-    return path;
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::vector<Node>
+ClosedOpenAddressPool<Node, HashFunction, N_Entries>::getPath(Node const node) const {
+    return tracePath(find(node));
 }
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 std::ostream &operator<<
 (std::ostream& os, ClosedOpenAddressPool<Node, HashFunction, N_Entries> const & closed) {
     os <<  "closed list load factor: "
-       << (double)(closed.size) / N_Entries << "\n";
+       << (double)(closed.size) / closed.n_entries << "\n";
     return os;
 }
 
@@ -0,0 +1,190 @@
+#ifndef CLOSED_RESIZABLE_HPP
+#define CLOSED_RESIZABLE_HPP
+
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include "boost/pool/object_pool.hpp"
+#include "pool_entry.hpp"
+
+/* Closed list using open addressing hash table with linear probing, growing
+ * when the load factor exceeds MAX_LOAD_FACTOR. Stores pointers to nodes
+ * allocated in a memory pool, so nodes are not moved when resizing, linked
+ * to the entry of their parent (see PoolEntry), found as in
+ * ClosedOpenAddressPool.
+ * Resizing is incremental, the table is replaced by one of twice the size
+ * and MIGRATE_PER_INSERT buckets of the previous table are moved on each
+ * insert, until the previous table is empty. While migrating, nodes are
+ * searched for in both tables. The table is never full, so probing always
+ * terminates.
+ * N_Entries is the default initial number of entries
+ */
+
+template <typename Node, typename HashFunction, size_t N_Entries = 1 << 16>
+struct ClosedResizable {
+    using Entry = PoolEntry<Node>;
+
+    static constexpr double MAX_LOAD_FACTOR = 0.5;
+    // at least 2, so migration finishes before the next resize is due
+    static constexpr size_t MIGRATE_PER_INSERT = 4;
+
+    boost::object_pool<Entry> pool{1024};
+
+    static const HashFunction hasher;
+
+    std::vector<Entry *> closed; // table nodes are inserted into
+    std::vector<Entry *> migrating; // previous table, empty unless resizing
+    size_t migrate_idx = 0; // next bucket of previous table to move
+
+    Entry const * last_inserted = nullptr;
+
+    explicit ClosedResizable(size_t n_entries = N_Entries)
+        : closed(std::max<size_t>(n_entries, 2)) {}
+
+    // returns true if node needs to be expanded,
+    // insert node if not already exist in closed, or if lower f-val than
+    // existing closed node (reopening)
+    bool insert(Node node);
+
+    // given node, return path in closed list by following parent entries
+    // assumes node is in the closed list; otherwise returns empty path
+    std::vector<Node> getPath(Node const node) const;
+
+    // index of node in table, or of the empty bucket ending its probe
+    static size_t probe(std::vector<Entry *> const & table, Node const & node);
+
+    // closed entry of node, nullptr if not in closed list
+    Entry const * find(Node const & node) const;
+
+    // closed entry of parent of node, nullptr if node has no parent
+    Entry const * findParent(Node const & node) const;
+
+    // allocate entry of node and its parent
+    Entry * construct(Node node);
+
+    // replace table with one of twice the size, start migrating
+    void grow();
+
+    // move up to n_buckets buckets of previous table to table
+    void migrate(size_t n_buckets);
+
+    size_t size = 0; // number of nodes in closed list
+    size_t n_resizes = 0;
+};
+
+template<typename Node, typename HashFunction, size_t N_Entries>
+const HashFunction
+ClosedResizable<Node, HashFunction, N_Entries>::hasher = HashFunction();
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+bool ClosedResizable<Node, HashFunction, N_Entries>::insert(Node node) {
+    migrate(MIGRATE_PER_INSERT);
+
+    auto & entry = closed[probe(closed, node)];
+    if (entry == nullptr && !migrating.empty()) {
+        auto old_entry = migrating[probe(migrating, node)];
+        if (old_entry != nullptr) { // found, not migrated yet
+            if (getF(node) < getF(old_entry->node)) { // reopening
+                // old entry is skipped when migrated, node already in table
+                entry = construct(std::move(node));
+                return true;
+            }
+            return false;
+        }
+    }
+
+    if (entry == nullptr) { // not found
+        entry = construct(std::move(node)); // insert
+        ++size;
+        if (size > MAX_LOAD_FACTOR * closed.size()) grow();
+        return true;
+    } else if (getF(node) < getF(entry->node)) { // reopening
+        entry = construct(std::move(node));
+        return true;
+    }
+    return false;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+typename ClosedResizable<Node, HashFunction, N_Entries>::Entry *
+ClosedResizable<Node, HashFunction, N_Entries>::construct(Node node) {
+    auto parent = findParent(node);
+    auto entry = pool.construct(Entry{std::move(node), parent});
+    last_inserted = entry;
+    return entry;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+size_t ClosedResizable<Node, HashFunction, N_Entries>::probe(
+        std::vector<Entry *> const & table, Node const & node) {
+    auto idx = hasher(node) % table.size();
+    while (table[idx] != nullptr && !(table[idx]->node == node)) { // collision
+        ++idx;
+        if (idx == table.size()) idx = 0; // wrap around
+    }
+    return idx;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+typename ClosedResizable<Node, HashFunction, N_Entries>::Entry const *
+ClosedResizable<Node, HashFunction, N_Entries>::find(Node const & node) const {
+    Entry const * entry = closed[probe(closed, node)];
+    if (entry == nullptr && !migrating.empty()) {
+        entry = migrating[probe(migrating, node)];
+    }
+    return entry;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+typename ClosedResizable<Node, HashFunction, N_Entries>::Entry const *
+ClosedResizable<Node, HashFunction, N_Entries>::findParent(Node const & node) const {
+    auto parent = getParent(node);
+    if (!parent.has_value()) return nullptr;
+    if (last_inserted != nullptr && last_inserted->node == *parent) {
+        return last_inserted;
+    }
+    return find(*parent);
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+void ClosedResizable<Node, HashFunction, N_Entries>::grow() {
+    migrate(migrating.size()); // finish previous resize
+    migrating.swap(closed);
+    closed = std::vector<Entry *>(2 * migrating.size());
+    migrate_idx = 0;
+    ++n_resizes;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+void ClosedResizable<Node, HashFunction, N_Entries>::migrate(size_t n_buckets) {
+    for (size_t i = 0; i < n_buckets && !migrating.empty(); ++i) {
+        auto entry_ptr = migrating[migrate_idx];
+        if (entry_ptr != nullptr) {
+            auto & entry = closed[probe(closed, entry_ptr->node)];
+            if (entry == nullptr) entry = entry_ptr; // not reopened since resize
+        }
+        ++migrate_idx;
+        if (migrate_idx == migrating.size()) { // done, free previous table
+            std::vector<Entry *>().swap(migrating);
+            migrate_idx = 0;
+        }
+    }
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::vector<Node>
+ClosedResizable<Node, HashFunction, N_Entries>::getPath(Node const node) const {
+    return tracePath(find(node));
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::ostream &operator<<
+(std::ostream& os, ClosedResizable<Node, HashFunction, N_Entries> const & closed) {
+    os <<  "closed list load factor: "
+       << (double)(closed.size) / closed.closed.size() << "\n";
+    os <<  "closed list entries: " << closed.closed.size() << "\n";
+    os <<  "closed list resizes: " << closed.n_resizes << "\n";
+    return os;
+}
+
+#endif
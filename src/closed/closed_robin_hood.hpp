@@ -0,0 +1,177 @@
+#ifndef CLOSED_ROBIN_HOOD_HPP
+#define CLOSED_ROBIN_HOOD_HPP
+
+#include <cstdint>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include "lazy_array.hpp"
+
+/* Closed list using open addressing hash table with linear probing and
+ * Robin Hood insertion: a node probing past an entry closer to its home
+ * bucket takes its place, and the displaced entry continues probing. Entries
+ * are ordered by displacement along a probe, which bounds the variance of
+ * probe lengths, and a probe ends at the first entry closer to its home
+ * than the node searched for. Nodes are only compared with entries of the
+ * same displacement, which have the same home bucket.
+ * Each entry stores its displacement plus one, zero if empty, entries are
+ * never deleted. Nodes are stored in place and must be trivially
+ * destructible.
+ * Probe lengths of inserts are counted in a histogram, reported with their
+ * mean and maximum.
+ * N_Entries is the default number of entries, allocated lazily (see
+ * LazyArray)
+ */
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+struct ClosedRobinHood {
+
+    static constexpr uint8_t MAX_PROBE_LENGTH = 0xFF;
+
+    static const HashFunction hasher;
+
+    size_t n_entries;
+
+    LazyArray<uint8_t> probe_lengths; // displacement + 1, zero if empty
+    LazyArray<Node> closed;
+
+    // probe_histogram[i], number of inserts with probe length i
+    std::vector<size_t> probe_histogram;
+
+    // memory of an entry
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(uint8_t) + sizeof(Node);
+
+    explicit ClosedRobinHood(size_t n_entries = N_Entries)
+        : n_entries(n_entries), probe_lengths(n_entries), closed(n_entries),
+          probe_histogram(MAX_PROBE_LENGTH + 1) {}
+
+    // returns true if node needs to be expanded,
+    // insert node if not already exist in closed, or if lower f-val than
+    // existing closed node (reopening)
+    // throws std::length_error if full or a probe exceeds MAX_PROBE_LENGTH
+    bool insert(Node const & node);
+
+    // given node, return path in closed list by tracing parent nodes
+    // assumes node is in the closed list; otherwise returns empty path
+    std::vector<Node> getPath(Node const & node) const;
+
+    // index of node, otherwise of the entry node would be inserted in
+    // sets probe_length to the probe length of node at that index
+    size_t probe(Node const & node, uint8_t & probe_length) const;
+
+    // place node with probe_length at idx, displacing entries closer to
+    // their home bucket until an empty entry is found
+    void place(Node node, uint8_t probe_length, size_t idx);
+
+    size_t size = 0; // number of nodes in closed list
+};
+
+template<typename Node, typename HashFunction, size_t N_Entries>
+const HashFunction
+ClosedRobinHood<Node, HashFunction, N_Entries>::hasher = HashFunction();
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+size_t ClosedRobinHood<Node, HashFunction, N_Entries>::
+probe(Node const & node, uint8_t & probe_length) const {
+    auto idx = hasher(node) % n_entries;
+    probe_length = 1;
+    // entries with shorter probes are closer to home, node would be there
+    while (probe_lengths[idx] >= probe_length) {
+        if (probe_lengths[idx] == probe_length && closed[idx] == node) {
+            return idx; // found
+        }
+        if (probe_length == MAX_PROBE_LENGTH) {
+            throw std::length_error("closed list probe length exceeded");
+        }
+        ++probe_length;
+        ++idx;
+        if (idx == n_entries) idx = 0; // wrap around
+    }
+    return idx;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+void ClosedRobinHood<Node, HashFunction, N_Entries>::
+place(Node node, uint8_t probe_length, size_t idx) {
+    while (probe_lengths[idx] != 0) {
+        if (probe_lengths[idx] < probe_length) { // take place of closer entry
+            std::swap(probe_lengths[idx], probe_length);
+            std::swap(closed[idx], node);
+        }
+        if (probe_length == MAX_PROBE_LENGTH) {
+            throw std::length_error("closed list probe length exceeded");
+        }
+        ++probe_length;
+        ++idx;
+        if (idx == n_entries) idx = 0; // wrap around
+    }
+    probe_lengths[idx] = probe_length;
+    closed[idx] = std::move(node);
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+bool ClosedRobinHood<Node, HashFunction, N_Entries>::insert(Node const & node) {
+    uint8_t probe_length;
+    auto idx = probe(node, probe_length);
+    ++probe_histogram[probe_length];
+    if (probe_lengths[idx] == probe_length && closed[idx] == node) { // found
+        if (getF(node) < getF(closed[idx])) { // reopening
+            closed[idx] = node;
+            return true;
+        }
+        return false;
+    }
+    // not found
+    if (size == n_entries) throw std::length_error("closed list is full");
+    place(node, probe_length, idx); // insert
+    ++size;
+    return true;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::vector<Node>
+ClosedRobinHood<Node, HashFunction, N_Entries>::getPath(Node const & node) const {
+    std::vector<Node> path;
+    std::optional<Node> to_find = node;
+
+    while (to_find.has_value()) {
+        uint8_t probe_length;
+        auto idx = probe(to_find.value(), probe_length);
+        if (probe_lengths[idx] != probe_length) return {}; // not in closed list
+        path.push_back(closed[idx]);
+        to_find = getParent(closed[idx]);
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::ostream &operator<<
+(std::ostream& os, ClosedRobinHood<Node, HashFunction, N_Entries> const & closed) {
+    size_t n_probes = 0;
+    size_t total_probe_length = 0;
+    size_t max_probe_length = 0;
+    for (size_t length = 0; length < closed.probe_histogram.size(); ++length) {
+        auto count = closed.probe_histogram[length];
+        n_probes += count;
+        total_probe_length += count * length;
+        if (count > 0) max_probe_length = length;
+    }
+    os <<  "closed list load factor: "
+       << (double)(closed.size) / closed.n_entries << "\n"
+       << "closed list mean probe length: "
+       << (double)(total_probe_length) / std::max<size_t>(n_probes, 1) << "\n"
+       << "closed list max probe length: " << max_probe_length << "\n"
+       << "closed list probe length histogram:";
+    for (size_t length = 1; length <= max_probe_length; ++length) {
+        os << " " << length << ":" << closed.probe_histogram[length];
+    }
+    os << "\n";
+    return os;
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef CLOSED_SWISS_HPP
+#define CLOSED_SWISS_HPP
+
+#include <cstdint>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "lazy_array.hpp"
+
+/* Closed list using open addressing hash table probed in groups of
+ * GROUP_SIZE entries (Swiss table). Each entry has a one byte control tag,
+ * zero if empty, otherwise the high bit set and 7 bits of the hash. Tags of
+ * a group are compared at once (SSE2 when available), nodes are only
+ * compared on a tag match, and a group with an empty entry ends the probe.
+ * Groups are probed linearly, from the group selected by the remaining bits
+ * of the hash. Nodes are stored in place and must be trivially destructible.
+ * N_Entries is the default number of entries, rounded up to whole groups,
+ * allocated lazily (see LazyArray)
+ */
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+struct ClosedSwiss {
+
+    static constexpr size_t GROUP_SIZE = 16;
+    static constexpr uint8_t FULL = 0x80;
+
+    static const HashFunction hasher;
+
+    size_t n_groups;
+
+    LazyArray<uint8_t> tags;
+    LazyArray<Node> closed;
+
+    // memory of an entry
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(uint8_t) + sizeof(Node);
+
+    explicit ClosedSwiss(size_t n_entries = N_Entries)
+        : n_groups(std::max<size_t>((n_entries + GROUP_SIZE - 1) / GROUP_SIZE, 1)),
+          tags(n_groups * GROUP_SIZE), closed(n_groups * GROUP_SIZE) {}
+
+    // returns true if node needs to be expanded,
+    // insert node if not already exist in closed, or if lower f-val than
+    // existing closed node (reopening)
+    bool insert(Node const & node);
+
+    // given node, return path in closed list by tracing parent nodes
+    // assumes node is in the closed list; otherwise returns empty path
+    std::vector<Node> getPath(Node const & node) const;
+
+    // index of node, or of the empty entry it would be inserted in, throws
+    // std::length_error if the closed list is full
+    size_t probe(Node const & node, uint8_t & tag) const;
+
+    // bit i is set if tag i of group equals tag
+    uint32_t matchTag(size_t group, uint8_t tag) const noexcept;
+
+    // bit i is set if entry i of group is empty
+    uint32_t matchEmpty(size_t group) const noexcept;
+
+    size_t size = 0; // number of nodes in closed list
+};
+
+template<typename Node, typename HashFunction, size_t N_Entries>
+const HashFunction
+ClosedSwiss<Node, HashFunction, N_Entries>::hasher = HashFunction();
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+uint32_t ClosedSwiss<Node, HashFunction, N_Entries>::
+matchTag(size_t group, uint8_t tag) const noexcept {
+#ifdef __SSE2__
+    auto group_tags = _mm_loadu_si128(
+        reinterpret_cast<__m128i const *>(&tags[group * GROUP_SIZE]));
+    auto tag_vector = _mm_set1_epi8(static_cast<char>(tag));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group_tags, tag_vector));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_SIZE; ++i) {
+        mask |= uint32_t(tags[group * GROUP_SIZE + i] == tag) << i;
+    }
+    return mask;
+#endif
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+uint32_t ClosedSwiss<Node, HashFunction, N_Entries>::
+matchEmpty(size_t group) const noexcept {
+    return matchTag(group, 0);
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+size_t ClosedSwiss<Node, HashFunction, N_Entries>::
+probe(Node const & node, uint8_t & tag) const {
+    auto hash = hasher(node);
+    tag = FULL | (hash & 0x7F);
+    auto group = (hash >> 7) % n_groups;
+    for (size_t i = 0; i < n_groups; ++i) {
+        for (auto mask = matchTag(group, tag); mask != 0; mask &= mask - 1) {
+            auto idx = group * GROUP_SIZE + __builtin_ctz(mask);
+            if (closed[idx] == node) return idx; // found
+        }
+        auto empty_mask = matchEmpty(group);
+        if (empty_mask != 0) { // not found
+            return group * GROUP_SIZE + __builtin_ctz(empty_mask);
+        }
+        ++group;
+        if (group == n_groups) group = 0; // wrap around
+    }
+    throw std::length_error("closed list is full");
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+bool ClosedSwiss<Node, HashFunction, N_Entries>::insert(Node const & node) {
+    uint8_t tag;
+    auto idx = probe(node, tag);
+    if (tags[idx] == 0) { // not found
+        tags[idx] = tag; // insert
+        closed[idx] = node;
+        ++size;
+        return true;
+    } else if (getF(node) < getF(closed[idx])) { // reopening
+        closed[idx] = node;
+        return true;
+    }
+    return false;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::vector<Node>
+ClosedSwiss<Node, HashFunction, N_Entries>::getPath(Node const & node) const {
+    std::vector<Node> path;
+    std::optional<Node> to_find = node;
+
+    while (to_find.has_value()) {
+        uint8_t tag;
+        auto idx = probe(to_find.value(), tag);
+        if (tags[idx] == 0) return {}; // not in closed list
+        path.push_back(closed[idx]);
+        to_find = getParent(closed[idx]);
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::ostream &operator<<
+(std::ostream& os, ClosedSwiss<Node, HashFunction, N_Entries> const & closed) {
+    os <<  "closed list load factor: "
+       << (double)(closed.size) / closed.closed.size() << "\n";
+    return os;
+}
+
+#endif
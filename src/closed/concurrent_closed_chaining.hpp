@@ -38,9 +38,13 @@ struct ConcurrentClosedChaining {
 
     static const HashFunction hasher;
 
+    size_t n_entries;
+
     std::vector< ForwardList<Node> > closed;
     
-    ConcurrentClosedChaining() : closed(N_Entries) {}
+    // N_Entries is the default number of buckets
+    explicit ConcurrentClosedChaining(size_t n_entries = N_Entries)
+        : n_entries(n_entries), closed(n_entries) {}
 
     // returns true if node needs to be expanded,
     // insert node if not already exist in closed, or if lower f-val than
@@ -63,7 +67,7 @@ ConcurrentClosedChaining<Node, HashFunction, N_Entries>::hasher = HashFunction()
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 bool ConcurrentClosedChaining<Node, HashFunction, N_Entries>::insert(Node const & node) {
-    size_t idx = hasher(node) % N_Entries;
+    size_t idx = hasher(node) % n_entries;
 
     auto & bucket = closed[idx];
 
@@ -94,7 +98,7 @@ std::vector<Node>
 ConcurrentClosedChaining<Node, HashFunction, N_Entries>::getPath(Node const & node) const {
     std::vector<Node> path;
     std::optional<Node> to_find = node;
-    size_t idx = hasher(*to_find) % N_Entries;
+    size_t idx = hasher(*to_find) % n_entries;
 
     while (to_find.has_value()) {
         auto & bucket = closed[idx];
@@ -104,7 +108,7 @@ ConcurrentClosedChaining<Node, HashFunction, N_Entries>::getPath(Node const & no
         if (it != bucket.forward_list.end()) { // found
             path.push_back(*it);
             to_find = getParent(*it);
-            if (to_find.has_value()) idx = hasher(to_find.value()) % N_Entries;
+            if (to_find.has_value()) idx = hasher(to_find.value()) % n_entries;
         }
     }
 
@@ -116,7 +120,7 @@ template <typename Node, typename HashFunction, size_t N_Entries>
 std::ostream &operator<<(std::ostream& os,
                          ConcurrentClosedChaining<Node, HashFunction, N_Entries> const & closed) {
     os <<  "closed list load factor: "
-       << (double)(closed.size) / N_Entries << "\n"
+       << (double)(closed.size) / closed.n_entries << "\n"
        << "closed list probes: " << closed.probe_count << "\n";
     return os;
 }
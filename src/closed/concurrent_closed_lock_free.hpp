@@ -0,0 +1,153 @@
+#ifndef CONCURRENT_CLOSED_LOCK_FREE_HPP
+#define CONCURRENT_CLOSED_LOCK_FREE_HPP
+
+#include <vector>
+#include <optional>
+#include <atomic>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include "boost/pool/object_pool.hpp"
+#include "lazy_array.hpp"
+
+/* Lock free concurrent closed list using open addressing hash table with
+ * linear probing, stores atomic pointers to nodes allocated by clients,
+ * e.g. using a memory pool per thread.
+ * Empty entries are claimed with compare and swap, on reopening the entry
+ * is swapped to the node with lower f-value only if it still holds the
+ * node compared against, so no entry is locked while probing. Stored nodes
+ * are never modified, only replaced. Each of the n_threads inserting
+ * threads counts its inserted nodes on its own cache line, summed by size.
+ * N_Entries is the default number of entries, allocated lazily (see
+ * LazyArray), entries are valid (empty) when zero
+ */
+template <typename Node, typename HashFunction, size_t N_Entries>
+struct ConcurrentClosedLockFree {
+
+    static const HashFunction hasher;
+
+    size_t n_entries;
+
+    LazyArray<std::atomic<Node *>> closed;
+
+    // nodes inserted by a thread, written by the thread only
+    struct alignas(64) ThreadSize {
+        size_t inserted = 0;
+    };
+
+    std::vector<ThreadSize> thread_sizes;
+
+    // memory of an entry and a stored node
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(std::atomic<Node *>) + sizeof(Node);
+
+    explicit ConcurrentClosedLockFree(size_t n_entries = N_Entries,
+                                      int n_threads = 1)
+        : n_entries(n_entries), closed(n_entries),
+          thread_sizes(std::max(n_threads, 1)) {}
+
+    // returns true if node needs to be expanded,
+    // insert node if not already exist in closed, or if lower f-val than
+    // existing closed node (reopening), throws std::length_error if the
+    // closed list is full, thread_id is the id of the inserting thread
+    bool insert(Node node, boost::object_pool<Node> & object_pool,
+                int thread_id = 0);
+
+    // given node, return path in closed list by tracing parent nodes
+    // assumes node is in the closed list; otherwise returns empty path
+    std::vector<Node> getPath(Node node);
+
+    // stored node equal to node, nullptr if not in closed list
+    Node const * find(Node const & node);
+
+    // number of nodes in closed list, once the inserting threads have joined
+    size_t size() const noexcept;
+};
+
+template<typename Node, typename HashFunction, size_t N_Entries>
+const HashFunction
+ConcurrentClosedLockFree<Node, HashFunction, N_Entries>::hasher = HashFunction();
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+bool ConcurrentClosedLockFree<Node, HashFunction, N_Entries>::
+insert(Node node, boost::object_pool<Node> & pool, int thread_id) {
+    // allocated once needed, kept in the pool if a compare and swap is lost
+    // and the node turns out not to be needed
+    Node * new_node_ptr = nullptr;
+
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries; ++i) {
+        auto node_ptr = closed[idx].load(std::memory_order_acquire);
+        if (node_ptr == nullptr) { // not found
+            if (new_node_ptr == nullptr) new_node_ptr = pool.construct(node);
+            if (closed[idx].compare_exchange_strong(node_ptr, new_node_ptr,
+                                                    std::memory_order_acq_rel)) {
+                ++thread_sizes[thread_id].inserted;
+                return true;
+            }
+            // lost race, node_ptr holds the node inserted by another thread
+        }
+        if (*node_ptr == node) { // found
+            while (getF(node) < getF(*node_ptr)) { // reopening
+                if (new_node_ptr == nullptr) new_node_ptr = pool.construct(node);
+                if (closed[idx].compare_exchange_weak(node_ptr, new_node_ptr,
+                                                      std::memory_order_acq_rel)) {
+                    return true;
+                }
+                // node_ptr reloaded, replaced by another thread
+            }
+            return false;
+        }
+        // collision
+        ++idx;
+        if (idx == n_entries) idx = 0; //wrap around
+    }
+    throw std::length_error("closed list is full");
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+Node const *
+ConcurrentClosedLockFree<Node, HashFunction, N_Entries>::find(Node const & node) {
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries; ++i) {
+        auto node_ptr = closed[idx].load(std::memory_order_acquire);
+        if (node_ptr == nullptr) return nullptr; // not in closed list
+        if (*node_ptr == node) return node_ptr; // found
+        ++idx;
+        if (idx == n_entries) idx = 0; // wrap around
+    }
+    return nullptr;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+size_t ConcurrentClosedLockFree<Node, HashFunction, N_Entries>::size() const noexcept {
+    size_t sum = 0;
+    for (auto const & thread_size : thread_sizes) sum += thread_size.inserted;
+    return sum;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::vector<Node>
+ConcurrentClosedLockFree<Node, HashFunction, N_Entries>::getPath(Node node) {
+    std::vector<Node> path;
+    std::optional<Node> to_find = node;
+
+    while (to_find.has_value()) {
+        auto node_ptr = find(*to_find);
+        if (node_ptr == nullptr) return {}; // not in closed list
+        path.push_back(*node_ptr);
+        to_find = getParent(*node_ptr);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+std::ostream &operator<<
+(std::ostream& os,
+ ConcurrentClosedLockFree<Node, HashFunction, N_Entries> const & closed) {
+    os <<  "closed list load factor: "
+       << (double)(closed.size()) / closed.n_entries << "\n";
+    return os;
+}
+
+#endif
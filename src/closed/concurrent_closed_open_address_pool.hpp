@@ -6,12 +6,17 @@
 #include <memory>
 #include <ostream>
 #include <algorithm>
+#include <stdexcept>
 #include "boost/pool/object_pool.hpp"
+#include "lazy_array.hpp"
 #include "spinlock.hpp"
 
 /* Concurrent closed list using open addressing hash table with linear probing
  * stores pointers instead of nodes, requires clients to allocate memory,
- * e.g. using a memory pool
+ * e.g. using a memory pool. Each of the n_threads inserting threads counts
+ * its inserted nodes on its own cache line, summed by size.
+ * N_Entries is the default number of entries, allocated lazily (see
+ * LazyArray), entries are valid (unlocked, empty) when zero
  */
 template<typename Node>
 struct ClosedEntry {
@@ -24,20 +29,44 @@ struct ConcurrentClosedOpenAddressPool {
 
     static const HashFunction hasher;
 
-    std::vector<ClosedEntry<Node>> closed;
+    size_t n_entries;
 
-    ConcurrentClosedOpenAddressPool() : closed(N_Entries) {}
+    LazyArray<ClosedEntry<Node>> closed;
+
+    // nodes inserted by a thread, written by the thread only
+    struct alignas(64) ThreadSize {
+        size_t inserted = 0;
+    };
+
+    std::vector<ThreadSize> thread_sizes;
+
+    // memory of an entry and a stored node
+    static constexpr size_t BYTES_PER_ENTRY = sizeof(ClosedEntry<Node>) + sizeof(Node);
+
+    explicit ConcurrentClosedOpenAddressPool(size_t n_entries = N_Entries,
+                                             int n_threads = 1)
+        : n_entries(n_entries), closed(n_entries),
+          thread_sizes(std::max(n_threads, 1)) {}
 
     // returns true if node needs to be expanded,
     // insert node if not already exist in closed, or if lower f-val than
-    // existing closed node (reopening)
-    bool insert(Node node, boost::object_pool<Node> & object_pool);
+    // existing closed node (reopening), throws std::length_error if the
+    // closed list is full, thread_id is the id of the inserting thread
+    bool insert(Node node, boost::object_pool<Node> & object_pool,
+                int thread_id = 0);
 
     // given node, return path in closed list by tracing parent nodes
     // assumes node is in the closed list; otherwise returns empty path
+    // not thread safe, entries are read without locking once threads
+    // inserting nodes have joined
     std::vector<Node> getPath(Node node);
 
-    std::atomic<size_t> size = 0; // number of nodes in closed list
+    // stored node equal to node, nullptr if not in closed list, not thread
+    // safe (see getPath)
+    Node const * find(Node const & node);
+
+    // number of nodes in closed list, once the inserting threads have joined
+    size_t size() const noexcept;
 };
 
 template<typename Node, typename HashFunction, size_t N_Entries>
@@ -46,15 +75,15 @@ ConcurrentClosedOpenAddressPool<Node, HashFunction, N_Entries>::hasher = HashFun
 
 template <typename Node, typename HashFunction, size_t N_Entries>
 bool ConcurrentClosedOpenAddressPool<Node, HashFunction, N_Entries>::
-insert(Node node, boost::object_pool<Node> & pool) {
-    auto idx = hasher(node) % N_Entries;
-    while (true) {
+insert(Node node, boost::object_pool<Node> & pool, int thread_id) {
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries; ++i) {
         closed[idx].mtx.lock();
         if (closed[idx].node_ptr == nullptr) { // not found
             auto node_ptr = pool.construct(node);
             closed[idx].node_ptr = node_ptr; // insert
             closed[idx].mtx.unlock();
-            ++size;
+            ++thread_sizes[thread_id].inserted;
             return true;
         } else if (*closed[idx].node_ptr == node) { // found
             if (getF(node) < getF(*closed[idx].node_ptr)) { // reopening
@@ -68,9 +97,30 @@ insert(Node node, boost::object_pool<Node> & pool) {
         } else { // collision
             closed[idx].mtx.unlock();
             ++idx;
-            if (idx == N_Entries) idx = 0; //wrap around
+            if (idx == n_entries) idx = 0; //wrap around
         }
     }
+    throw std::length_error("closed list is full");
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+Node const *
+ConcurrentClosedOpenAddressPool<Node, HashFunction, N_Entries>::find(Node const & node) {
+    auto idx = hasher(node) % n_entries;
+    for (size_t i = 0; i < n_entries && closed[idx].node_ptr != nullptr; ++i) {
+        if (*closed[idx].node_ptr == node) return closed[idx].node_ptr; // found
+        ++idx;
+        if (idx == n_entries) idx = 0; // wrap around
+    }
+    return nullptr;
+}
+
+template <typename Node, typename HashFunction, size_t N_Entries>
+size_t
+ConcurrentClosedOpenAddressPool<Node, HashFunction, N_Entries>::size() const noexcept {
+    size_t sum = 0;
+    for (auto const & thread_size : thread_sizes) sum += thread_size.inserted;
+    return sum;
 }
 
 template <typename Node, typename HashFunction, size_t N_Entries>
@@ -78,20 +128,12 @@ std::vector<Node>
 ConcurrentClosedOpenAddressPool<Node, HashFunction, N_Entries>::getPath(Node node) {
     std::vector<Node> path;
     std::optional<Node> to_find = node;
-    auto idx = hasher(*to_find) % N_Entries;
 
     while (to_find.has_value()) {
-        closed[idx].mtx.lock();
-        if (*closed[idx].node_ptr == to_find) { // found
-            path.push_back(*closed[idx].node_ptr);
-            to_find = getParent(*closed[idx].node_ptr);
-            if (to_find.has_value()) idx = hasher(to_find.value()) % N_Entries;
-            closed[idx].mtx.unlock();
-        } else {
-            closed[idx].mtx.unlock();
-            ++idx;
-            if (idx == N_Entries) idx = 0; // wrap around
-        }
+        auto node_ptr = find(*to_find);
+        if (node_ptr == nullptr) return {}; // not in closed list
+        path.push_back(*node_ptr);
+        to_find = getParent(*node_ptr);
     }
     std::reverse(path.begin(), path.end());
     return path;
@@ -102,7 +144,7 @@ std::ostream &operator<<
 (std::ostream& os,
  ConcurrentClosedOpenAddressPool<Node, HashFunction, N_Entries> const & closed) {
     os <<  "closed list load factor: "
-       << (double)(closed.size) / N_Entries << "\n";
+       << (double)(closed.size()) / closed.n_entries << "\n";
     return os;
 }
 
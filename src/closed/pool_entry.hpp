@@ -0,0 +1,28 @@
+#ifndef POOL_ENTRY_HPP
+#define POOL_ENTRY_HPP
+
+#include <vector>
+#include <algorithm>
+
+/* Node allocated in a memory pool by a closed list, linked to the entry of
+ * its parent, so paths are rebuilt by following parent pointers instead of
+ * probing the closed list for each parent
+ */
+template <typename Node>
+struct PoolEntry {
+    Node node;
+    PoolEntry const * parent = nullptr;
+};
+
+// path from the initial node to the node of entry
+template <typename Node>
+std::vector<Node> tracePath(PoolEntry<Node> const * entry) {
+    std::vector<Node> path;
+    for (; entry != nullptr; entry = entry->parent) {
+        path.push_back(entry->node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+#endif
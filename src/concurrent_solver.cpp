@@ -1,15 +1,26 @@
+#include "closed_open_address.hpp"
 #include "concurrent_astar.hpp"
+#include "concurrent_closed_lock_free.hpp"
+#include "concurrent_closed_open_address_pool.hpp"
 #include "concurrent_search.hpp"
 #include "cxxopts.hpp"
+#include "hdastar.hpp"
 #include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "parallel_idastar.hpp"
 #include "steady_clock_timer.hpp"
 #include "tabulation.hpp"
 #include "tile_node.hpp"
 #include "util.hpp"
+#include "walking_distance_heuristic.hpp"
+#include "zobrist.hpp"
 #include <array>
 #include <iostream>
+#include <memory>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 using namespace Tiles;
 
@@ -17,12 +28,71 @@ int const WIDTH = 4;
 int const HEIGHT = 4;
 int const N_TILES = WIDTH * HEIGHT;
 
-using Node = TileNode<WIDTH, HEIGHT>;
-using Heuristic = ManhattanDistanceHeuristic<WIDTH, HEIGHT>;
-using HashFunction = TabulationHash<Node, WIDTH * HEIGHT>;
+using Node = PackedTileNode<WIDTH, HEIGHT>;
+// using Node = TileNode<WIDTH, HEIGHT>;
+using HashFunction = ZobristHash<Node>;
+// using HashFunction = TabulationHash<Node, WIDTH * HEIGHT>;
 size_t const ClosedEntries = 512927357;
 // using HashFunction = std::hash<Node>;
 
+using ClosedList =
+    ConcurrentClosedOpenAddressPool<Node, HashFunction, ClosedEntries>;
+
+using HDAClosedList = ClosedOpenAddress<Node, HashFunction, ClosedEntries>;
+
+using LockFreeClosedList =
+    ConcurrentClosedLockFree<Node, HashFunction, ClosedEntries>;
+
+template <typename Heuristic>
+using DefaultConcurrentAStar =
+    ConcurrentAStar<Node, Heuristic, HashFunction, ClosedEntries, ClosedList>;
+template <typename Heuristic>
+using DefaultHDAStar =
+    HDAStar<Node, Heuristic, HashFunction, ClosedEntries, HDAClosedList>;
+template <typename Heuristic>
+using LockFreeConcurrentAStar =
+    ConcurrentAStar<Node, Heuristic, HashFunction, ClosedEntries,
+                    LockFreeClosedList>;
+
+// closed list size options, entries allocated lazily
+struct ClosedSize {
+  size_t capacity = ClosedEntries;
+  size_t memory_budget_mb = 0;
+};
+
+// returns search algorithm using heuristic, nullptr if invalid option
+// if deterministic, threads take turns, so runs with the same seed and number
+// of threads report the same expanded and generated counts
+// concurrent_astar searches push children into open batch_size at a time
+template <typename Heuristic>
+std::unique_ptr<ConcurrentSearch<Node>>
+makeConcurrentSearch(std::string const &search_string, int n_threads,
+                     int frontier_depth, ClosedSize const &closed_size,
+                     bool deterministic, size_t batch_size) {
+  if (search_string == "concurrent_astar") {
+    return std::make_unique<DefaultConcurrentAStar<Heuristic>>(
+        Heuristic(), n_threads,
+        getClosedEntries<ClosedList>(closed_size.capacity,
+                                     closed_size.memory_budget_mb),
+        deterministic, batch_size);
+  } else if (search_string == "concurrent_astar_lock_free") {
+    return std::make_unique<LockFreeConcurrentAStar<Heuristic>>(
+        Heuristic(), n_threads,
+        getClosedEntries<LockFreeClosedList>(closed_size.capacity,
+                                             closed_size.memory_budget_mb),
+        deterministic, batch_size);
+  } else if (search_string == "hdastar") {
+    return std::make_unique<DefaultHDAStar<Heuristic>>(
+        Heuristic(), n_threads,
+        getClosedEntries<HDAClosedList>(closed_size.capacity,
+                                        closed_size.memory_budget_mb));
+  } else if (search_string == "parallel_idastar") {
+    return std::make_unique<ParallelIDAStar<Node, Heuristic>>(
+        Heuristic(), n_threads, frontier_depth, deterministic);
+  }
+  return nullptr;
+}
+
 int main(int argc, char *argv[]) {
 
   cxxopts::Options options(
@@ -39,8 +109,42 @@ int main(int argc, char *argv[]) {
       "goal state configuration "
       "e.g. \"1 2 3 7 4 5 6 0 8 9 10 11 12 13 14 15\"",
       cxxopts::value<std::string>()->default_value(""))(
-      "s,search_algorithm", "search algorithm [concurrent_astar]",
+      "s,search_algorithm",
+      "search algorithm [concurrent_astar, concurrent_astar_lock_free, "
+      "hdastar, parallel_idastar]",
       cxxopts::value<std::string>()->default_value("concurrent_astar"))(
+      "t,threads", "number of threads, default number of cores",
+      cxxopts::value<int>()->default_value(
+          std::to_string(std::thread::hardware_concurrency())))(
+      "frontier_depth",
+      "depth at which parallel_idastar splits the search tree into work "
+      "items",
+      cxxopts::value<int>()->default_value("10"))(
+      "closed_capacity",
+      "number of closed list entries of concurrent_astar and hdastar "
+      "searches, split between threads by hdastar",
+      cxxopts::value<size_t>()->default_value(std::to_string(ClosedEntries)))(
+      "memory_budget",
+      "closed list memory in MB of concurrent_astar and hdastar searches, "
+      "overrides closed_capacity",
+      cxxopts::value<size_t>()->default_value("0"))(
+      "seed",
+      "seed of hash functions, which also distribute nodes to threads, same "
+      "seed gives same hash values",
+      cxxopts::value<uint64_t>()->default_value(
+          std::to_string(std::mt19937_64::default_seed)))(
+      "deterministic",
+      "reproducible search, threads take turns to expand nodes (work items "
+      "of parallel_idastar), so runs with the same seed and number of "
+      "threads report the same expanded and generated counts, not supported "
+      "by hdastar")(
+      "batch_size",
+      "number of children a concurrent_astar thread collects per destination "
+      "bucket before pushing them into open under a single lock, 1 pushes "
+      "each child",
+      cxxopts::value<size_t>()->default_value("1"))(
+      "e,heuristic", "heuristic [manhattan, walking_distance]",
+      cxxopts::value<std::string>()->default_value("manhattan"))(
       "h,help", "print help");
 
   // parse command line
@@ -55,6 +159,11 @@ int main(int argc, char *argv[]) {
   auto goal_tiles_string = result["goal_state"].as<std::string>();
 
   try {
+    // seed hash functions before constructing nodes
+    auto seed = result["seed"].as<uint64_t>();
+    Node::seedHash(seed);
+    TabulationHash<Node, N_TILES>::seed(seed);
+
     // read tiles
     // for generic node perhaps modify constructor to take in string
     auto initial_node = Node(getBoardFromString<N_TILES>(initial_tiles_string));
@@ -69,10 +178,37 @@ int main(int argc, char *argv[]) {
     auto timer = SteadyClockTimer();
     timer.start();
 
-    if (search_string == "concurrent_astar") {
-      concurrent_search_algo = std::make_unique<
-          ConcurrentAStar<Node, Heuristic, HashFunction, ClosedEntries>>();
+    auto heuristic_string = result["heuristic"].as<std::string>();
+    auto n_threads = result["threads"].as<int>();
+    auto frontier_depth = result["frontier_depth"].as<int>();
+    ClosedSize closed_size;
+    closed_size.capacity = result["closed_capacity"].as<size_t>();
+    closed_size.memory_budget_mb = result["memory_budget"].as<size_t>();
+    auto deterministic = result["deterministic"].as<bool>();
+    auto batch_size = result["batch_size"].as<size_t>();
+
+    if (deterministic && search_string == "hdastar") {
+      std::cerr << "--deterministic is not supported by hdastar\n";
+      return EXIT_FAILURE;
+    }
+
+    if (heuristic_string == "manhattan") {
+      concurrent_search_algo =
+          makeConcurrentSearch<ManhattanDistanceHeuristic<WIDTH, HEIGHT>>(
+              search_string, n_threads, frontier_depth, closed_size,
+              deterministic, batch_size);
+    } else if (heuristic_string == "walking_distance") {
+      concurrent_search_algo =
+          makeConcurrentSearch<WalkingDistanceHeuristic<WIDTH, HEIGHT>>(
+              search_string, n_threads, frontier_depth, closed_size,
+              deterministic, batch_size);
     } else {
+      std::cerr << "Invalid heuristic option: "
+                << "\"" << heuristic_string << "\"\n";
+      return EXIT_FAILURE;
+    }
+
+    if (!concurrent_search_algo) {
       std::cerr << "Invalid search algorithm option: "
                 << "\"" << search_string << "\"\n";
       return EXIT_FAILURE;
@@ -85,7 +221,8 @@ int main(int argc, char *argv[]) {
     std::cout << timer.getElapsedTime<milliseconds>()
               << " ms to solve (including initialization)\n"
               << *concurrent_search_algo << "\n"
-              << "n moves: " << path.size() - 1 << "\n"
+              << "n moves: " << (path.empty() ? -1 : getG(path.back()))
+              << "\n"
               << "sequence:\n";
 
     for (auto node : path) {
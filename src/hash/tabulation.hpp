@@ -11,25 +11,38 @@
 #include <memory>
 
 // Zobrist hashing a.k.a Simple Tabulation Hashing
-// Using Mersenne Twister 64 bit pseudorandom number generator, seeded by
-// Minimal Standard generator (simple multiplicative congruential)
+// Using Mersenne Twister 64 bit pseudorandom number generator, by default
+// with its default seed. The table is shared by all hash functions of the
+// same type, so it can be reseeded after static hash functions (e.g. of
+// closed lists) are constructed, and the same seed gives the same hash
+// values on every run.
 template<typename Entry, int N_Variables>
 class TabulationHash {
 
-    std::array< std::array<size_t, N_Variables>, N_Variables> table;
-        
+    using Table = std::array< std::array<size_t, N_Variables>, N_Variables>;
+
+    static Table makeTable(uint64_t seed);
+
+    static Table & table() {
+        static Table table = makeTable(std::mt19937_64::default_seed);
+        return table;
+    }
+
 public:
-    TabulationHash();
-        
+    // regenerate table from seed, before searching
+    static void seed(uint64_t seed) {
+        table() = makeTable(seed);
+    }
+
     size_t operator()(const Entry & entry) const; // hash value
 };
 
 template<class Entry, int N_Variables>
-TabulationHash<Entry, N_Variables>::TabulationHash() 
+typename TabulationHash<Entry, N_Variables>::Table
+TabulationHash<Entry, N_Variables>::makeTable(uint64_t seed)
 {
-
-    std::mt19937_64 rng;
-    rng.seed(std::random_device()());
+    Table table;
+    std::mt19937_64 rng(seed);
     std::uniform_int_distribution<std::mt19937_64::result_type>
         dist(0,std::numeric_limits<std::mt19937_64::result_type>::max());
     // fill table with random bitstrings (64 bit)
@@ -38,10 +51,12 @@ TabulationHash<Entry, N_Variables>::TabulationHash()
             val = dist(rng);
         }
     }
+    return table;
 }
 
 template<class Entry, int N_Variables>
 size_t TabulationHash<Entry, N_Variables>::operator()(const Entry& entry) const {
+    auto const & table = TabulationHash::table();
     size_t hash_value = 0;
 #ifdef TWISTED
     size_t i = 0;
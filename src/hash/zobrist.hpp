@@ -0,0 +1,102 @@
+#ifndef ZOBRIST_HASH_HPP
+#define ZOBRIST_HASH_HPP
+
+#include <random>
+#include <limits>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Zobrist hashing with a single table per number of tiles, so hash values
+// agree for all nodes and hash functions, and can be cached in nodes and
+// updated when a tile moves. The blank is not hashed, its position follows
+// from the positions of the other tiles, so a move updates the hash value
+// with two XORs. Hash values of boards of up to 16 tiles are 32 bit, to fit
+// in the padding of packed nodes, larger boards have 64 bit hash values.
+// Keys are pseudorandom from a seed, the same seed gives the same hash values
+// on every run.
+template<int N_TILES>
+using ZobristValue = std::conditional_t<(N_TILES <= 16), uint32_t, uint64_t>;
+
+template<int N_TILES>
+class ZobristTable {
+
+    using Value = ZobristValue<N_TILES>;
+
+    // keys[idx][tile], key of tile at board index idx, zero for the blank
+    std::array< std::array<Value, N_TILES>, N_TILES> keys;
+
+    explicit ZobristTable(uint64_t seed);
+
+    static ZobristTable & instance() {
+        static ZobristTable table(std::mt19937_64::default_seed);
+        return table;
+    }
+
+public:
+    static ZobristTable const & get() {
+        return instance();
+    }
+
+    // regenerate keys from seed, before searching, hash values computed
+    // before (e.g. cached in nodes) are no longer valid
+    static void seed(uint64_t seed) {
+        instance() = ZobristTable(seed);
+    }
+
+    // hash value of board, iterable over the tiles in board index order
+    template<typename Board>
+    Value hash(Board const & board) const noexcept {
+        Value hash_value = 0;
+        int idx = 0;
+        for (auto tile : board) {
+            hash_value ^= keys[idx][tile];
+            ++idx;
+        }
+        return hash_value;
+    }
+
+    // hash value after tile moves from board index from_idx to to_idx
+    Value move(Value hash_value, uint8_t tile,
+                  int from_idx, int to_idx) const noexcept {
+        return hash_value ^ keys[from_idx][tile] ^ keys[to_idx][tile];
+    }
+};
+
+// Using Mersenne Twister 64 bit pseudorandom number generator, by default
+// with its default seed
+template<int N_TILES>
+ZobristTable<N_TILES>::ZobristTable(uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<Value>
+        dist(0, std::numeric_limits<Value>::max());
+    for (auto& idx_keys : keys) {
+        idx_keys[0] = 0; // blank
+        for (int tile = 1; tile < N_TILES; ++tile) {
+            idx_keys[tile] = dist(rng);
+        }
+    }
+}
+
+// hash function returning the Zobrist hash value of a node, found by
+// getHash(node), which nodes may cache and update incrementally. Values of
+// fewer than 64 bits are spread over all 64 bits (Fibonacci hashing), so
+// indexes taken from high bits (e.g. ClosedSwiss groups) vary too. There
+// are at most 2^BITS distinct values, a hash table can't use more entries
+// (see getClosedEntries).
+template<typename Node>
+struct ZobristHash {
+    static constexpr int BITS =
+        8 * sizeof(decltype(getHash(std::declval<Node const &>())));
+
+    size_t operator()(Node const & node) const noexcept {
+        if constexpr (BITS < 64) {
+            return getHash(node) * 0x9E3779B97F4A7C15;
+        } else {
+            return getHash(node);
+        }
+    }
+};
+
+#endif
@@ -2,15 +2,19 @@
 #define OPEN_ARRAY_MUTEX_HPP
 
 #include <array>
+#include <atomic>
 #include <vector>
 #include <mutex>
+#include <optional>
 #include "spinlock.hpp"
 
-template <typename Node, int MAX_MOVES, typename HashFunction, int N_THREADS>
+template <typename Node, int MAX_MOVES, typename HashFunction>
 struct ConcurrentOpenArray {
 
     HashFunction hasher;
 
+    int const n_threads;
+
     // bucket indexed by g value
     struct GBucket {
         std::vector<Node> nodes;
@@ -33,49 +37,67 @@ struct ConcurrentOpenArray {
     };
 
     // priority queue, indexed by thread id, f, then g
-    std::array<ThreadBucket, N_THREADS> queue;
+    std::vector<ThreadBucket> queue;
+
+    explicit ConcurrentOpenArray(int n_threads)
+        : n_threads(n_threads), queue(n_threads) {}
+
+    // thread id of the bucket node is pushed into, unless disabled
+    int owner(Node const & node) const {
+        return hasher(node) % n_threads;
+    }
 
     // inserts node into open list
     void push(Node node) {
-        auto f = getF(node);
-        auto g = getG(node);
+        auto & thread_bucket = lockEnabled(owner(node));
+        insert(thread_bucket, std::move(node));
+        thread_bucket.mtx.unlock();
+    }
 
-        int thread_id = hasher(node) % N_THREADS;
-        
+    // inserts nodes into the bucket of thread_id (or the next enabled
+    // bucket) under a single lock, and clears nodes
+    void push(int thread_id, std::vector<Node> & nodes) {
+        if (nodes.empty()) return;
+        auto & thread_bucket = lockEnabled(thread_id);
+        for (auto & node : nodes) {
+            insert(thread_bucket, std::move(node));
+        }
+        thread_bucket.mtx.unlock();
+        nodes.clear();
+    }
+
+    // locks and returns bucket of thread_id, or of the next thread whose
+    // bucket is not disabled
+    ThreadBucket & lockEnabled(int thread_id) {
         queue[thread_id].mtx.lock();
         while (queue[thread_id].disabled) {
             queue[thread_id].mtx.unlock();
             ++thread_id;
-            if (thread_id == N_THREADS) thread_id = 0;
+            if (thread_id == n_threads) thread_id = 0;
             queue[thread_id].mtx.lock();
         }
-        
-        auto & thread_bucket = queue[thread_id];
+        return queue[thread_id];
+    }
+
+    // inserts node into locked thread_bucket
+    static void insert(ThreadBucket & thread_bucket, Node node) {
+        auto f = getF(node);
+        auto g = getG(node);
         auto & f_bucket = thread_bucket.f_buckets[f];
         auto & g_bucket = f_bucket.g_buckets[g];
-        
+
         // update min f, max g if necessary
-        if (f < thread_bucket.min_f) thread_bucket.min_f = f;        
+        if (f < thread_bucket.min_f) thread_bucket.min_f = f;
         if (g > f_bucket.max_g) f_bucket.max_g = g;
-        
+
         g_bucket.nodes.emplace_back(std::move(node));
         ++thread_bucket.size;
-        thread_bucket.mtx.unlock();
     }
 
     // pops and returns node from open list
     std::optional<Node> pop(int thread_id) {
         
-        queue[thread_id].mtx.lock();
-        while (queue[thread_id].disabled) {
-            queue[thread_id].mtx.unlock();
-            
-            ++thread_id;
-            if (thread_id == N_THREADS) thread_id = 0;
-            queue[thread_id].mtx.lock();
-        }
-        
-        auto & thread_bucket = queue[thread_id];
+        auto & thread_bucket = lockEnabled(thread_id);
         
         if (thread_bucket.size == 0) {
             thread_bucket.mtx.unlock();
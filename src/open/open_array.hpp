@@ -67,6 +67,13 @@ struct OpenArray {
         return node;
     }
 
+    // returns minimum f value of nodes in open list, MAX_MOVES if empty
+    int minF() noexcept {
+        if (size == 0) return MAX_MOVES;
+        if (queue[min_f][max_g].empty()) updateFG();
+        return min_f;
+    }
+
     // returns true if queue is empty, also updates f and g
     bool empty() noexcept {
         if (size == 0) return true;
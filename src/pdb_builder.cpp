@@ -0,0 +1,101 @@
+#include "cxxopts.hpp"
+#include "pattern_database_heuristic.hpp"
+#include "steady_clock_timer.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace Tiles;
+
+int const WIDTH = 4;
+int const HEIGHT = 4;
+
+// build and save each group of partition, one file per group
+template <typename Storage>
+void buildPatternDatabases(Partition const &partition, int n_threads,
+                           std::string const &prefix) {
+  for (size_t group = 0; group < partition.size(); ++group) {
+    auto timer = SteadyClockTimer();
+    timer.start();
+
+    auto database =
+        PatternDatabase<WIDTH, HEIGHT, Storage>(partition[group], n_threads);
+    auto filename = prefix + "_" + std::to_string(group) + ".pdb";
+    database.save(filename);
+
+    std::cout << timer.getElapsedTime<milliseconds>() << " ms to build "
+              << filename << " (tiles";
+    for (auto tile : partition[group]) {
+      std::cout << " " << static_cast<int>(tile);
+    }
+    std::cout << ", " << database.table_size << " bytes)\n";
+  }
+}
+
+int main(int argc, char *argv[]) {
+
+  cxxopts::Options options(
+      "Pattern Database Builder",
+      "Builds pattern databases of the sliding tiles puzzle.");
+  // command line options
+  options.add_options("Build")(
+      "p,partition",
+      "pattern database partition [663, 78, 6666] or groups of tiles "
+      "e.g. \"1 2 3 4 5 6 7, 8 9 10 11 12 13 14 15\", "
+      "default 663 for the 15 puzzle, 6666 for the 24 puzzle",
+      cxxopts::value<std::string>()->default_value(""))(
+      "t,threads", "number of threads, default number of cores",
+      cxxopts::value<int>()->default_value(
+          std::to_string(std::thread::hardware_concurrency())))(
+      "o,output", "output file prefix, one file <prefix>_<group>.pdb per group",
+      cxxopts::value<std::string>()->default_value("pdb"))(
+      "c,pdb_storage", "pattern database storage [byte, nibble, mod3]",
+      cxxopts::value<std::string>()->default_value("byte"))("h,help",
+                                                           "print help");
+
+  // parse command line
+  auto result = options.parse(argc, argv);
+
+  if (result.count("h")) {
+    std::cout << options.help({"", "Build"}) << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  try {
+    auto partition_string = result["partition"].as<std::string>();
+    auto partition = partition_string.empty()
+                         ? getDefaultPartition<WIDTH, HEIGHT>()
+                         : getPartitionFromString(partition_string);
+    PatternDatabaseHeuristic<WIDTH, HEIGHT>::checkPartition(partition);
+
+    auto n_threads = result["threads"].as<int>();
+    auto prefix = result["output"].as<std::string>();
+
+    auto storage_string = result["pdb_storage"].as<std::string>();
+
+    if (storage_string == "byte") {
+      buildPatternDatabases<ByteStorage>(partition, n_threads, prefix);
+    } else if (storage_string == "nibble") {
+      buildPatternDatabases<NibbleStorage>(partition, n_threads, prefix);
+    } else if (storage_string == "mod3") {
+      buildPatternDatabases<Mod3Storage>(partition, n_threads, prefix);
+    } else {
+      std::cerr << "Invalid pattern database storage option: "
+                << "\"" << storage_string << "\"\n";
+      return EXIT_FAILURE;
+    }
+  }
+  // handle errors
+  catch (const std::invalid_argument &ia) {
+    std::cerr << "Invalid argument: " << ia.what() << "\n";
+    return EXIT_FAILURE;
+  } catch (const std::bad_alloc &ba) {
+    std::cerr << "Memory allocation failed : " << ba.what() << "\n";
+    return EXIT_FAILURE;
+  } catch (const std::exception &e) {
+    std::cerr << "Build failed: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
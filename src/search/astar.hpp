@@ -20,6 +20,14 @@ struct AStar : public Search<Node> {
     Open  open;
     Closed closed;
 
+    AStar() = default;
+
+    explicit AStar(Heuristic heuristic) : heuristic(std::move(heuristic)) {}
+
+    // closed list with closed_entries entries instead of its default
+    AStar(Heuristic heuristic, size_t closed_entries)
+        : heuristic(std::move(heuristic)), closed(closed_entries) {}
+
     // perform A* search and returns solution path
     std::vector<Node>
     search(Node initial_node) override final {
@@ -41,7 +49,7 @@ struct AStar : public Search<Node> {
                 for (auto child_node : child_nodes) {
                     if (child_node.has_value()) {
                         ++Search<Node>::generated;
-                        evalH(*child_node, heuristic);
+                        evalChild(*node, *child_node, heuristic);
                         open.push(std::move(*child_node));
                     }
                 }
@@ -1,84 +1,250 @@
 #ifndef CONCURRENT_ASTAR_HPP
 #define CONCURRENT_ASTAR_HPP
 
+#include <algorithm>
+#include <exception>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <thread>
 #include "boost/pool/object_pool.hpp"
 #include "concurrent_search.hpp"
 #include "concurrent_open_array.hpp"
 #include "concurrent_closed_open_address_pool.hpp"
+#include "backoff.hpp"
+#include "lockstep.hpp"
 
-int const N_THREADS = 6;
-
+/* Concurrent A* Search with n_threads threads, each thread pops from its
+ * own bucket of the open list and allocates closed entries from its own
+ * object pool.
+ * The search ends when a goal is found and no bucket has a node with a lower
+ * f value (see ConcurrentOpenArray::kill_open), or when the search space is
+ * exhausted. Each thread counts the nodes it pushes and the nodes it has
+ * finished (popped and expanded or discarded), a thread whose bucket is
+ * empty sums the counts of all threads twice, and the search space is
+ * exhausted if no count changed and all pushed nodes are finished. Idle
+ * threads back off (see Backoff).
+ * If batch_size > 1, children are added to an outbox per destination bucket
+ * and pushed batch_size nodes at a time under a single lock. All outboxes
+ * of a thread are pushed every batch_size steps, when its bucket is empty,
+ * and before it stops once a goal is found, so no node is held back for
+ * long or lost. Children are counted as pushed when added to an outbox.
+ * If deterministic, threads take steps (pop and expand a node) one at a
+ * time in thread id order (see Lockstep), so runs with the same hash seed
+ * and number of threads expand and generate the same nodes.
+ */
 template <typename Node, typename Heuristic,
           typename HashFunction, size_t ClosedEntries = 512927357,
           typename Closed = ConcurrentClosedOpenAddressPool<Node, HashFunction, ClosedEntries>,
-          typename Open = ConcurrentOpenArray<Node, 100, HashFunction, N_THREADS> >
+          typename Open = ConcurrentOpenArray<Node, 100, HashFunction> >
 struct ConcurrentAStar : public ConcurrentSearch<Node> {
-    
+
+    // result of a step of a thread
+    enum class Step { EXPANDED, IDLE, DONE };
+
+    // termination counts of a thread, written by the thread only
+    struct alignas(64) NodeCounts {
+        std::atomic<size_t> pushed = 0;
+        std::atomic<size_t> finished = 0;
+    };
+
+    // children not yet pushed into open, written by the thread only
+    struct alignas(64) Outboxes {
+        std::vector<std::vector<Node>> nodes; // indexed by destination
+        size_t steps = 0; // steps since the outboxes were pushed
+        size_t batches = 0; // batches pushed
+    };
+
     std::mutex mtx;
+    int const n_threads;
+    size_t const batch_size;
     Open open;
     Closed closed;
     Heuristic  heuristic;
     std::atomic<bool> node_found = false;
-    std::array<boost::object_pool<Node>, N_THREADS> object_pools;
+    std::vector<boost::object_pool<Node>> object_pools;
     std::atomic<int> goal_f = std::numeric_limits<int>::max();
+    Lockstep lockstep;
+    std::vector<NodeCounts> node_counts;
+    std::vector<Outboxes> outboxes;
+
+    explicit ConcurrentAStar(Heuristic heuristic = Heuristic(),
+                             int n_threads = std::thread::hardware_concurrency(),
+                             size_t closed_entries = ClosedEntries,
+                             bool deterministic = false,
+                             size_t batch_size = 1)
+        : ConcurrentSearch<Node>(std::max(n_threads, 1)),
+          n_threads(std::max(n_threads, 1)),
+          batch_size(std::max<size_t>(batch_size, 1)), open(this->n_threads),
+          closed(closed_entries, this->n_threads), heuristic(std::move(heuristic)),
+          object_pools(this->n_threads),
+          lockstep(this->n_threads, deterministic),
+          node_counts(this->n_threads), outboxes(this->n_threads) {
+        for (auto & thread_outboxes : outboxes) {
+            thread_outboxes.nodes.resize(this->n_threads);
+        }
+    }
     
     // perform A* search and returns solution path
     std::vector<Node>
     search(Node initial_node) override final {
         evalH(initial_node, heuristic);
-        ++ConcurrentSearch<Node>::generated;
+        ++this->counts(0).generated;
+        ++node_counts[0].pushed;
         open.push(std::move(initial_node));
+        lockstep.reset();
 
         std::vector<std::thread> threads;
-        for (int i = 0; i < N_THREADS; ++i) {
+        for (int i = 0; i < n_threads; ++i) {
             threads.push_back(std::thread(&ConcurrentAStar::worker, this, i));
         }
         for (auto & t : threads) {
             t.join();
         }
+        this->rethrowFailure();
         return closed.getPath(Node::goal_node);
     }
 
     void worker(int thread_id) {
-        
+        Backoff backoff;
         while (true) {
-            // synchronize return of all threads, if at least one solution found
-            if (node_found == true) {
-                if (open.kill_open(thread_id, goal_f)) {
-                    return;
-                }
+            lockstep.wait(thread_id);
+            Step result;
+            try {
+                result = this->failed ? Step::DONE : step(thread_id);
+            } catch (...) { // e.g. closed list is full, stop all threads
+                this->fail(std::current_exception());
+                result = Step::DONE;
             }
-            
-            auto node = open.pop(thread_id);
-            
-            if (node.has_value()) {
-                if (closed.insert(*node, object_pools[thread_id])) {
-                    // check goal node
-                    if (isGoal(*node)) {
-                        node_found = true;
-                        std::lock_guard<std::mutex> lock(mtx);
-                        if (getF(*node) < goal_f) goal_f = getF(*node);
-                        continue;
-                    }
-                    auto child_nodes = getChildNodes(*node);
-                    ++ConcurrentSearch<Node>::expanded;
-                    for (auto child_node : child_nodes) {
-                        if (child_node.has_value()) {
-                            ++ConcurrentSearch<Node>::generated;
-                            evalH(*child_node, heuristic);
-                            open.push(std::move(*child_node));
-                        }
+            if (result == Step::DONE) {
+                lockstep.leave(thread_id);
+                return;
+            }
+            lockstep.pass(thread_id);
+            if (result == Step::EXPANDED) {
+                backoff.reset();
+            } else if (!lockstep.isEnabled()) {
+                backoff.pause();
+            }
+        }
+    }
+
+    // pop and expand a node
+    Step step(int thread_id) {
+        // synchronize return of all threads, if at least one solution found
+        if (node_found == true) {
+            pushOutboxes(thread_id);
+            if (open.kill_open(thread_id, goal_f)) {
+                return Step::DONE;
+            }
+        }
+
+        if (batch_size > 1 && ++outboxes[thread_id].steps >= batch_size) {
+            pushOutboxes(thread_id);
+        }
+
+        auto node = open.pop(thread_id);
+        if (!node.has_value()) {
+            pushOutboxes(thread_id);
+            return isExhausted() ? Step::DONE : Step::IDLE;
+        }
+
+        auto & counts = node_counts[thread_id];
+        auto & thread_counts = this->counts(thread_id);
+        if (closed.insert(*node, object_pools[thread_id], thread_id)) {
+            // check goal node
+            if (isGoal(*node)) {
+                node_found = true;
+                std::lock_guard<std::mutex> lock(mtx);
+                if (getF(*node) < goal_f) goal_f = getF(*node);
+            } else {
+                auto child_nodes = getChildNodes(*node);
+                ++thread_counts.expanded;
+                for (auto child_node : child_nodes) {
+                    if (child_node.has_value()) {
+                        ++thread_counts.generated;
+                        evalChild(*node, *child_node, heuristic);
+                        // counted before it can be popped
+                        increment(counts.pushed);
+                        push(thread_id, std::move(*child_node));
                     }
                 }
             }
-        }          
+        }
+        increment(counts.finished);
+        return Step::EXPANDED;
+    }
+
+    // push node into open, or into the outbox of its destination, pushing
+    // the outbox once it holds batch_size nodes
+    void push(int thread_id, Node node) {
+        if (batch_size == 1) {
+            open.push(std::move(node));
+            return;
+        }
+        auto dest = open.owner(node);
+        auto & outbox = outboxes[thread_id].nodes[dest];
+        outbox.push_back(std::move(node));
+        if (outbox.size() >= batch_size) {
+            open.push(dest, outbox);
+            ++outboxes[thread_id].batches;
+        }
+    }
+
+    // push all outboxes of thread_id into open
+    void pushOutboxes(int thread_id) {
+        auto & thread_outboxes = outboxes[thread_id];
+        thread_outboxes.steps = 0;
+        for (int dest = 0; dest < n_threads; ++dest) {
+            auto & outbox = thread_outboxes.nodes[dest];
+            if (outbox.empty()) continue;
+            open.push(dest, outbox);
+            ++thread_outboxes.batches;
+        }
+    }
+
+    // increment count written by this thread only, without a locked
+    // read-modify-write
+    static void increment(std::atomic<size_t> & count) noexcept {
+        count.store(count.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+    // sums of pushed and finished counts of all threads
+    std::pair<size_t, size_t>
+    sumNodeCounts(std::vector<size_t> & counts) const {
+        size_t pushed = 0;
+        size_t finished = 0;
+        for (int i = 0; i < n_threads; ++i) {
+            counts[2 * i] = node_counts[i].pushed.load(std::memory_order_acquire);
+            counts[2 * i + 1] =
+                node_counts[i].finished.load(std::memory_order_acquire);
+            pushed += counts[2 * i];
+            finished += counts[2 * i + 1];
+        }
+        return {pushed, finished};
+    }
+
+    // true if every pushed node is finished, counts are read twice, and are
+    // exact if unchanged between the reads, as they only increase
+    bool isExhausted() const {
+        std::vector<size_t> first(2 * n_threads);
+        std::vector<size_t> second(2 * n_threads);
+        auto [pushed, finished] = sumNodeCounts(first);
+        if (pushed != finished) return false;
+        sumNodeCounts(second);
+        return first == second;
     }
 
     std::ostream& print(std::ostream& os) const override final {
         os << closed;
+        if (batch_size > 1) {
+            size_t batches = 0;
+            for (auto const & thread_outboxes : outboxes) {
+                batches += thread_outboxes.batches;
+            }
+            os << "open batches pushed: " << batches << "\n";
+        }
         return os;
     }
 };
@@ -1,28 +1,80 @@
 #ifndef CONCURRENT_SEARCH_HPP
 #define CONCURRENT_SEARCH_HPP
 
+#include <atomic>
+#include <exception>
 #include <ostream>
 #include <vector>
-#include <atomic>
 
 // interface for search algorithms, tracks node generation and expansion counts
+// per thread, each on its own cache line and written by its thread only,
+// aggregated on demand once the threads have joined
+// an exception thrown by a thread (e.g. a full closed list) is kept, the
+// other threads stop once failed is set, and search rethrows it once the
+// threads have joined
 template<typename Node>
 struct ConcurrentSearch {
-    std::atomic<size_t> expanded = 0;
-    std::atomic<size_t> generated = 0;
+
+    struct alignas(64) ThreadCounts {
+        size_t expanded = 0;
+        size_t generated = 0;
+    };
+
+    std::vector<ThreadCounts> thread_counts;
+
+    std::atomic<bool> failed = false;
+    std::exception_ptr failure; // first exception thrown by a thread
+
+    explicit ConcurrentSearch(int n_threads = 1)
+        : thread_counts(n_threads) {}
+
     virtual std::vector<Node> search(Node initial_node) = 0;
     virtual ~ConcurrentSearch() = default;
 
+    // counts of thread_id, counts of nodes generated before threads start
+    // are added to thread 0
+    ThreadCounts & counts(int thread_id) noexcept {
+        return thread_counts[thread_id];
+    }
+
+    // keep the first exception thrown by a thread
+    void fail(std::exception_ptr exception) noexcept {
+        if (!failed.exchange(true)) failure = exception;
+    }
+
+    // rethrow the exception of a failed thread, once the threads have joined
+    void rethrowFailure() const {
+        if (failure) std::rethrow_exception(failure);
+    }
+
+    size_t expanded() const noexcept {
+        size_t sum = 0;
+        for (auto const & counts : thread_counts) sum += counts.expanded;
+        return sum;
+    }
+
+    size_t generated() const noexcept {
+        size_t sum = 0;
+        for (auto const & counts : thread_counts) sum += counts.generated;
+        return sum;
+    }
+
     // for logging
     virtual std::ostream& print(std::ostream& os) const = 0;
 };
 
 template<typename Node>
 std::ostream &operator<<(std::ostream & os, ConcurrentSearch<Node> const &search) {
-    os << "expanded: " << search.expanded << "\n";
-    os << "generated: " << search.generated << "\n";
+    os << "expanded: " << search.expanded() << "\n";
+    os << "generated: " << search.generated() << "\n";
+    os << "expanded per thread:";
+    for (auto const & counts : search.thread_counts) os << " " << counts.expanded;
+    os << "\n";
+    os << "generated per thread:";
+    for (auto const & counts : search.thread_counts) os << " " << counts.generated;
+    os << "\n";
     search.print(os);
-    return os;     
+    return os;
 }
 
 #endif
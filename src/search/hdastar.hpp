@@ -0,0 +1,266 @@
+#ifndef HDASTAR_HPP
+#define HDASTAR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "backoff.hpp"
+#include "concurrent_search.hpp"
+#include "open_array.hpp"
+#include "closed_open_address.hpp"
+
+/* Hash Distributed A* Search (HDA*) with n_threads threads. Each node is
+ * owned by the thread selected by its hash value, and each thread has a
+ * private open list and a private partition of the closed list, so no
+ * locks are taken while expanding. Children owned by another thread are
+ * added to an outbox per destination and sent in batches of BATCH_SIZE
+ * nodes (or when the thread runs out of work) to the inbox of their owner,
+ * a lock free multiple producer single consumer stack of batches.
+ * Termination is detected asynchronously with a single counter of active
+ * threads plus batches in flight: a batch is counted before it is sent and
+ * uncounted after it is received, a thread is counted unless it is idle
+ * (no open node below the best goal f value, no messages), so the counter
+ * is zero only once every thread is idle and no batch is in flight. Idle
+ * threads back off (see Backoff).
+ * Closed requires insert(node) and find(node), returning a pointer to the
+ * stored node or nullptr. Parents are looked up in the partition of their
+ * owner to trace the path, so partitions don't link entries to parents
+ * (the parent of a node is usually owned by another thread).
+ */
+template <typename Node, typename Heuristic,
+          typename HashFunction, size_t ClosedEntries = 512927357,
+          typename Closed = ClosedOpenAddress<Node, HashFunction, ClosedEntries>,
+          typename Open = OpenArray<Node, 100> >
+struct HDAStar : public ConcurrentSearch<Node> {
+
+    static constexpr size_t BATCH_SIZE = 64;
+
+    // nodes sent to a thread, linked in its inbox
+    struct Batch {
+        std::vector<Node> nodes;
+        Batch * next = nullptr;
+    };
+
+    // search state owned by a thread
+    struct Worker {
+        Open open;
+        Closed closed;
+        std::atomic<Batch *> inbox = nullptr;
+        std::vector<std::vector<Node>> outboxes; // indexed by destination
+        size_t sent = 0; // nodes sent to other threads
+        size_t batches = 0; // batches sent to other threads
+
+        Worker(size_t closed_entries, int n_threads)
+            : closed(closed_entries), outboxes(n_threads) {}
+    };
+
+    static const HashFunction hasher;
+
+    int const n_threads;
+    Heuristic heuristic;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> goal_f = std::numeric_limits<int>::max();
+    std::atomic<int> active = 0; // threads not idle plus batches in flight
+
+    // closed_entries are split evenly between the partitions of the threads
+    explicit HDAStar(Heuristic heuristic = Heuristic(),
+                     int n_threads = std::thread::hardware_concurrency(),
+                     size_t closed_entries = ClosedEntries)
+        : ConcurrentSearch<Node>(std::max(n_threads, 1)),
+          n_threads(std::max(n_threads, 1)), heuristic(std::move(heuristic)) {
+        auto partition_entries =
+            std::max<size_t>(closed_entries / this->n_threads, 1);
+        for (int i = 0; i < this->n_threads; ++i) {
+            workers.push_back(std::make_unique<Worker>(partition_entries,
+                                                       this->n_threads));
+        }
+    }
+
+    ~HDAStar() override {
+        for (auto & worker : workers) {
+            freeBatches(worker->inbox.exchange(nullptr));
+        }
+    }
+
+    // thread owning node, the hash value is mixed (Fibonacci hashing) so
+    // the closed partitions, indexed by the same hash value, use all entries
+    int owner(Node const & node) const noexcept {
+        uint64_t hash_value = hasher(node);
+        return static_cast<int>(((hash_value * 0x9E3779B97F4A7C15) >> 32) %
+                                n_threads);
+    }
+
+    // perform HDA* search and returns solution path
+    std::vector<Node>
+    search(Node initial_node) override final {
+        evalH(initial_node, heuristic);
+        ++this->counts(0).generated;
+        workers[owner(initial_node)]->open.push(std::move(initial_node));
+        active = n_threads;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < n_threads; ++i) {
+            threads.push_back(std::thread(&HDAStar::worker, this, i));
+        }
+        for (auto & t : threads) {
+            t.join();
+        }
+        this->rethrowFailure();
+        return getPath(Node::goal_node);
+    }
+
+    void worker(int thread_id) {
+        try {
+            run(thread_id);
+        } catch (...) { // e.g. closed partition is full, stop all threads
+            this->fail(std::current_exception());
+        }
+    }
+
+    // expand nodes of this thread until no thread is active or a thread
+    // failed
+    void run(int thread_id) {
+        auto & state = *workers[thread_id];
+        bool idle = false;
+        Backoff backoff;
+        while (!this->failed.load(std::memory_order_relaxed)) {
+            receive(state, idle);
+            if (!state.open.empty() &&
+                state.open.minF() < goal_f.load(std::memory_order_relaxed)) {
+                expand(thread_id, state);
+                backoff.reset();
+                continue;
+            }
+            // out of work, send partial batches before going idle
+            for (int dest = 0; dest < n_threads; ++dest) {
+                send(state, dest);
+            }
+            if (!idle) {
+                idle = true;
+                active.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            if (active.load(std::memory_order_acquire) == 0) return;
+            backoff.pause();
+        }
+    }
+
+    // pop a node, insert it into closed and expand it, keeping children
+    // owned by this thread and adding the others to outboxes
+    void expand(int thread_id, Worker & state) {
+        auto node = state.open.pop();
+        if (!state.closed.insert(*node)) return;
+        if (isGoal(*node)) {
+            auto f = goal_f.load(std::memory_order_relaxed);
+            while (getF(*node) < f &&
+                   !goal_f.compare_exchange_weak(f, getF(*node),
+                                                 std::memory_order_relaxed));
+            return;
+        }
+        auto & thread_counts = this->counts(thread_id);
+        auto child_nodes = getChildNodes(*node);
+        ++thread_counts.expanded;
+        for (auto child_node : child_nodes) {
+            if (!child_node.has_value()) continue;
+            ++thread_counts.generated;
+            evalChild(*node, *child_node, heuristic);
+            auto dest = owner(*child_node);
+            if (dest == thread_id) {
+                state.open.push(std::move(*child_node));
+                continue;
+            }
+            auto & outbox = state.outboxes[dest];
+            outbox.push_back(std::move(*child_node));
+            if (outbox.size() >= BATCH_SIZE) send(state, dest);
+        }
+    }
+
+    // send outbox of dest as a batch, counted as active until received
+    void send(Worker & state, int dest) {
+        auto & outbox = state.outboxes[dest];
+        if (outbox.empty()) return;
+        state.sent += outbox.size();
+        ++state.batches;
+        auto batch = new Batch{std::move(outbox)};
+        outbox = std::vector<Node>();
+        outbox.reserve(BATCH_SIZE);
+        active.fetch_add(1, std::memory_order_acq_rel);
+        auto & inbox = workers[dest]->inbox;
+        batch->next = inbox.load(std::memory_order_relaxed);
+        while (!inbox.compare_exchange_weak(batch->next, batch,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+    }
+
+    // push nodes of received batches into open, an idle thread becomes
+    // active before the batches are uncounted
+    void receive(Worker & state, bool & idle) {
+        if (state.inbox.load(std::memory_order_relaxed) == nullptr) return;
+        auto batch = state.inbox.exchange(nullptr, std::memory_order_acquire);
+        if (idle) {
+            idle = false;
+            active.fetch_add(1, std::memory_order_acq_rel);
+        }
+        while (batch != nullptr) {
+            for (auto & node : batch->nodes) {
+                state.open.push(std::move(node));
+            }
+            auto next = batch->next;
+            delete batch;
+            batch = next;
+            active.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    static void freeBatches(Batch * batch) {
+        while (batch != nullptr) {
+            auto next = batch->next;
+            delete batch;
+            batch = next;
+        }
+    }
+
+    // given node, return path by tracing parent nodes in the closed
+    // partitions of their owners, empty if node is not in the closed list
+    std::vector<Node> getPath(Node const & node) const {
+        std::vector<Node> path;
+        std::optional<Node> to_find = node;
+        while (to_find.has_value()) {
+            auto closed_node = workers[owner(*to_find)]->closed.find(*to_find);
+            if (closed_node == nullptr) return {};
+            path.push_back(*closed_node);
+            to_find = getParent(*closed_node);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    std::ostream& print(std::ostream& os) const override final {
+        size_t closed_size = 0;
+        size_t sent = 0;
+        size_t batches = 0;
+        for (auto & worker : workers) {
+            closed_size += worker->closed.size;
+            sent += worker->sent;
+            batches += worker->batches;
+        }
+        os << "closed list size: " << closed_size << "\n"
+           << "nodes sent to other threads: " << sent << "\n"
+           << "batches sent: " << batches << "\n";
+        return os;
+    }
+};
+
+template <typename Node, typename Heuristic, typename HashFunction,
+          size_t ClosedEntries, typename Closed, typename Open>
+const HashFunction
+HDAStar<Node, Heuristic, HashFunction, ClosedEntries, Closed, Open>::hasher =
+    HashFunction();
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef IDASTAR_HPP
 #define IDASTAR_HPP
 
+#include <algorithm>
 #include <vector>
 #include <limits>
 #include "search.hpp"
@@ -14,6 +15,10 @@ struct IDAStar : public Search<Node> {
     int min_next_threshold;
     std::vector<Node> path;
 
+    IDAStar() = default;
+
+    explicit IDAStar(Heuristic heuristic) : heuristic(std::move(heuristic)) {}
+
     std::vector<Node>
     search(Node initial_node) override final {
 
@@ -53,7 +58,7 @@ struct IDAStar : public Search<Node> {
         for (auto child_node : child_nodes) {
             if (child_node.has_value()) {
                 ++Search<Node>::generated;
-                evalH(*child_node, heuristic);
+                evalChild(node, *child_node, heuristic);
                 bool goal_found = dfs(*child_node);
                 if (goal_found) {
                     path.push_back(node);
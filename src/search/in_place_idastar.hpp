@@ -0,0 +1,92 @@
+#ifndef IN_PLACE_IDASTAR_HPP
+#define IN_PLACE_IDASTAR_HPP
+
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "search.hpp"
+
+/* Iterative Deepening A* Search on a single node modified in place.
+ * Children are generated by applying a move to the node and evaluated
+ * incrementally, the move is undone when backtracking, so no node is
+ * copied during the search. The path is kept as a stack of moves.
+ */
+template<typename Node, typename Heuristic>
+struct InPlaceIDAStar : public Search<Node> {
+    using Move = decltype(Node::prev_move);
+
+    Heuristic heuristic;
+    int threshold;
+    int min_next_threshold;
+    Node node;
+    std::vector<Move> moves;
+
+    InPlaceIDAStar() = default;
+
+    explicit InPlaceIDAStar(Heuristic heuristic) : heuristic(std::move(heuristic)) {}
+
+    std::vector<Node>
+    search(Node initial_node) override final {
+
+        evalH(initial_node, heuristic);
+        ++Search<Node>::generated;
+        threshold = getF(initial_node);
+        node = initial_node;
+        moves.clear();
+
+        while (true) {
+            min_next_threshold = std::numeric_limits<int>::max();
+            auto goal_found = dfs();
+            if (goal_found) break;
+            threshold = min_next_threshold;
+            std::cout << "Current f layer: " << threshold << "\n";
+        }
+
+        // replay moves from initial node
+        std::vector<Node> path = {initial_node};
+        for (auto move : moves) {
+            auto next_node = path.back();
+            applyMove(next_node, move);
+            evalMoved(next_node, heuristic);
+            path.push_back(next_node);
+        }
+        return path;
+    }
+
+    bool dfs() {
+
+        auto f = getF(node);
+        if (f <= threshold && isGoal(node)) { // optimal goal node found
+            return true;
+        }
+
+        if (f > threshold) {
+            if (f < min_next_threshold) { // potential value for next threshold
+                min_next_threshold = f;
+            }
+            return false; // threshold exceeded
+        }
+
+        // restored when moves are undone
+        auto prev_move = node.prev_move;
+        auto h_val = node.h_val;
+
+        ++Search<Node>::expanded;
+        for (auto move : getMoves(node)) {
+            if (!applyMove(node, move)) continue;
+            ++Search<Node>::generated;
+            evalMoved(node, heuristic);
+            moves.push_back(move);
+            if (dfs()) return true;
+            moves.pop_back();
+            undoMove(node, move, prev_move, h_val);
+        }
+        return false;
+    }
+
+    std::ostream& print(std::ostream& os) const override final {
+        return os;
+    }
+};
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef PARALLEL_IDASTAR_HPP
+#define PARALLEL_IDASTAR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "barrier.hpp"
+#include "concurrent_search.hpp"
+#include "lockstep.hpp"
+
+/* Parallel Iterative Deepening A* Search.
+ * Threads are started once per search and kept for all threshold
+ * iterations, meeting the searching thread at a barrier before and after
+ * each iteration.
+ * Each threshold iteration, the tree is searched in place to the frontier
+ * depth, and the frontier nodes within the threshold become work items,
+ * dealt round robin to one queue per thread. Threads search their items in
+ * place, taking items from the back of their own queue and stealing from
+ * the front of other queues when theirs is empty. The minimum f value
+ * exceeding the threshold is reduced over all threads, and all threads stop
+ * once a goal is found, as any goal within the threshold is optimal.
+ * If deterministic, threads search one work item at a time in thread id
+ * order (see Lockstep), so runs with the same number of threads expand and
+ * generate the same nodes.
+ */
+template<typename Node, typename Heuristic>
+struct ParallelIDAStar : public ConcurrentSearch<Node> {
+    using Move = decltype(Node::prev_move);
+
+    // frontier node, and moves from the initial node to it
+    struct WorkItem {
+        Node node;
+        std::vector<Move> moves;
+    };
+
+    // work item queue of a thread
+    struct WorkQueue {
+        std::mutex mtx;
+        std::deque<WorkItem> items;
+    };
+
+    // search state of a thread
+    struct Worker {
+        Node node;
+        std::vector<Move> moves;
+        size_t expanded = 0;
+        size_t generated = 0;
+    };
+
+    Heuristic heuristic;
+    int n_threads;
+    int frontier_depth;
+    int threshold;
+    std::atomic<int> min_next_threshold;
+    std::atomic<bool> goal_found;
+    bool stopping = false; // workers return at the next iteration barrier
+    std::vector<Move> goal_moves;
+    std::vector<WorkQueue> queues;
+    Lockstep lockstep;
+    Barrier barrier; // of the searching thread and the workers
+
+    explicit ParallelIDAStar(Heuristic heuristic = Heuristic(),
+                             int n_threads = std::thread::hardware_concurrency(),
+                             int frontier_depth = 10,
+                             bool deterministic = false)
+        : ConcurrentSearch<Node>(std::max(n_threads, 1)),
+          heuristic(std::move(heuristic)),
+          n_threads(std::max(n_threads, 1)),
+          frontier_depth(frontier_depth),
+          queues(this->n_threads),
+          lockstep(this->n_threads, deterministic),
+          barrier(this->n_threads + 1) {}
+
+    std::vector<Node>
+    search(Node initial_node) override final {
+
+        evalH(initial_node, heuristic);
+        ++this->counts(0).generated;
+        threshold = getF(initial_node);
+        goal_moves.clear();
+        stopping = false;
+
+        std::vector<std::thread> threads;
+        for (int thread_id = 0; thread_id < n_threads; ++thread_id) {
+            threads.emplace_back(&ParallelIDAStar::worker, this, thread_id);
+        }
+
+        while (true) {
+            min_next_threshold = std::numeric_limits<int>::max();
+            goal_found = false;
+            for (auto & queue : queues) {
+                queue.items.clear();
+            }
+
+            Worker root;
+            root.node = initial_node;
+            size_t n_items = 0;
+            collect(root, n_items);
+            addCounts(0, root);
+
+            if (!goal_found) {
+                lockstep.reset();
+                barrier.wait(); // start iteration
+                barrier.wait(); // workers are done
+            }
+            if (goal_found) break;
+            threshold = min_next_threshold;
+            std::cout << "Current f layer: " << threshold << "\n";
+        }
+
+        stopping = true;
+        barrier.wait();
+        for (auto & thread : threads) {
+            thread.join();
+        }
+
+        // replay moves from initial node
+        std::vector<Node> path = {initial_node};
+        for (auto move : goal_moves) {
+            auto next_node = path.back();
+            applyMove(next_node, move);
+            evalMoved(next_node, heuristic);
+            path.push_back(next_node);
+        }
+        return path;
+    }
+
+    void updateMinNextThreshold(int f) noexcept {
+        auto min_f = min_next_threshold.load(std::memory_order_relaxed);
+        while (f < min_f &&
+               !min_next_threshold.compare_exchange_weak(min_f, f,
+                                                         std::memory_order_relaxed));
+    }
+
+    // record moves to goal of first thread finding one
+    void setGoal(Worker const & worker) {
+        if (!goal_found.exchange(true)) {
+            goal_moves = worker.moves;
+        }
+    }
+
+    // true if node is within threshold and not a goal, otherwise handles it
+    bool isExpandable(Worker & worker) {
+        auto f = getF(worker.node);
+        if (f > threshold) {
+            updateMinNextThreshold(f);
+            return false;
+        }
+        if (isGoal(worker.node)) { // optimal goal node found
+            setGoal(worker);
+            return false;
+        }
+        return true;
+    }
+
+    // generate children of worker node in place, calling visit on each
+    // child, stops when visit returns true (goal found)
+    template <typename Visit>
+    bool forEachChild(Worker & worker, Visit visit) {
+        // restored when moves are undone
+        auto prev_move = worker.node.prev_move;
+        auto h_val = worker.node.h_val;
+
+        ++worker.expanded;
+        for (auto move : getMoves(worker.node)) {
+            if (!applyMove(worker.node, move)) continue;
+            ++worker.generated;
+            evalMoved(worker.node, heuristic);
+            worker.moves.push_back(move);
+            if (visit()) return true;
+            worker.moves.pop_back();
+            undoMove(worker.node, move, prev_move, h_val);
+        }
+        return false;
+    }
+
+    // search to frontier depth, deal frontier nodes to queues
+    bool collect(Worker & worker, size_t & n_items) {
+        if (!isExpandable(worker)) return goal_found;
+        if (static_cast<int>(worker.moves.size()) == frontier_depth) {
+            queues[n_items++ % n_threads].items.push_back(
+                WorkItem{worker.node, worker.moves});
+            return false;
+        }
+        return forEachChild(worker, [&] { return collect(worker, n_items); });
+    }
+
+    bool dfs(Worker & worker) {
+        if (goal_found.load(std::memory_order_relaxed)) return true;
+        if (!isExpandable(worker)) return goal_found;
+        return forEachChild(worker, [&] { return dfs(worker); });
+    }
+
+    // next work item, from own queue, otherwise stolen from other queues
+    std::optional<WorkItem> getWorkItem(int thread_id) {
+        for (int i = 0; i < n_threads; ++i) {
+            auto & queue = queues[(thread_id + i) % n_threads];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            if (queue.items.empty()) continue;
+            std::optional<WorkItem> item;
+            if (i == 0) {
+                item = std::move(queue.items.back());
+                queue.items.pop_back();
+            } else {
+                item = std::move(queue.items.front());
+                queue.items.pop_front();
+            }
+            return item;
+        }
+        return {};
+    }
+
+    // search work items of each iteration, between the iteration barriers
+    void worker(int thread_id) {
+        Worker worker;
+        while (true) {
+            barrier.wait();
+            if (stopping) break;
+            lockstep.wait(thread_id);
+            while (auto item = getWorkItem(thread_id)) {
+                if (!goal_found.load(std::memory_order_relaxed)) {
+                    worker.node = item->node;
+                    worker.moves = std::move(item->moves);
+                    dfs(worker);
+                } // otherwise drain
+                lockstep.pass(thread_id);
+                lockstep.wait(thread_id);
+            }
+            lockstep.leave(thread_id);
+            barrier.wait();
+        }
+        addCounts(thread_id, worker);
+    }
+
+    void addCounts(int thread_id, Worker const & worker) {
+        auto & thread_counts = this->counts(thread_id);
+        thread_counts.expanded += worker.expanded;
+        thread_counts.generated += worker.generated;
+    }
+
+    std::ostream& print(std::ostream& os) const override final {
+        return os;
+    }
+};
+
+#endif
@@ -1,16 +1,28 @@
 #include "astar.hpp"
+#include "closed_chaining.hpp"
+#include "closed_compact.hpp"
 #include "closed_open_address_pool.hpp"
+#include "closed_resizable.hpp"
+#include "closed_robin_hood.hpp"
+#include "closed_swiss.hpp"
 #include "cxxopts.hpp"
 #include "idastar.hpp"
+#include "in_place_idastar.hpp"
+#include "linear_conflict_heuristic.hpp"
 #include "manhattan_distance_heuristic.hpp"
 #include "open_array.hpp"
+#include "packed_tile_node.hpp"
+#include "pattern_database_heuristic.hpp"
 #include "search.hpp"
 #include "steady_clock_timer.hpp"
 #include "tabulation.hpp"
 #include "tile_node.hpp"
 #include "util.hpp"
+#include "walking_distance_heuristic.hpp"
+#include "zobrist.hpp"
 #include <array>
 #include <iostream>
+#include <random>
 #include <stdexcept>
 #include <string>
 
@@ -20,18 +32,104 @@ int const WIDTH = 4;
 int const HEIGHT = 4;
 int const N_TILES = WIDTH * HEIGHT;
 
-using Node = TileNode<WIDTH, HEIGHT>;
-using Heuristic = ManhattanDistanceHeuristic<WIDTH, HEIGHT>;
-using HashFunction = TabulationHash<Node, WIDTH * HEIGHT>;
+using Node = PackedTileNode<WIDTH, HEIGHT>;
+// using Node = TileNode<WIDTH, HEIGHT>;
+using HashFunction = ZobristHash<Node>;
+// using HashFunction = TabulationHash<Node, WIDTH * HEIGHT>;
 size_t const ClosedEntries = 512927357;
 int const MaxMoves = 100;
 
-using DefaultAStar = AStar<Node, Heuristic, HashFunction>;
-using AStarPool =
-    AStar<Node, Heuristic, HashFunction,
-          ClosedOpenAddressPool<Node, HashFunction, ClosedEntries>,
+using ClosedChainingList = ClosedChaining<Node, HashFunction, ClosedEntries>;
+using ClosedPoolList = ClosedOpenAddressPool<Node, HashFunction, ClosedEntries>;
+using ClosedCompactList = ClosedCompact<Node, HashFunction, ClosedEntries>;
+using ClosedSwissList = ClosedSwiss<Node, HashFunction, ClosedEntries>;
+using ClosedRobinHoodList = ClosedRobinHood<Node, HashFunction, ClosedEntries>;
+
+template <typename Heuristic>
+using DefaultAStar = AStar<Node, Heuristic, HashFunction, ClosedChainingList>;
+template <typename Heuristic>
+using AStarPool = AStar<Node, Heuristic, HashFunction, ClosedPoolList,
+                        OpenArray<Node, MaxMoves>>;
+template <typename Heuristic>
+using AStarCompact = AStar<Node, Heuristic, HashFunction, ClosedCompactList,
+                           OpenArray<Node, MaxMoves>>;
+template <typename Heuristic>
+using AStarSwiss = AStar<Node, Heuristic, HashFunction, ClosedSwissList,
+                         OpenArray<Node, MaxMoves>>;
+template <typename Heuristic>
+using AStarRobinHood = AStar<Node, Heuristic, HashFunction, ClosedRobinHoodList,
+                             OpenArray<Node, MaxMoves>>;
+template <typename Heuristic>
+using AStarResizable =
+    AStar<Node, Heuristic, HashFunction, ClosedResizable<Node, HashFunction>,
           OpenArray<Node, MaxMoves>>;
 
+// closed list size options, entries allocated lazily
+struct ClosedSize {
+  size_t capacity = ClosedEntries;
+  size_t memory_budget_mb = 0;
+};
+
+// returns search algorithm using heuristic, nullptr if invalid option
+template <typename Heuristic>
+std::unique_ptr<Search<Node>> makeSearch(std::string const &search_string,
+                                         Heuristic heuristic,
+                                         ClosedSize const &closed_size) {
+  if (search_string == "astar") {
+    return std::make_unique<DefaultAStar<Heuristic>>(
+        std::move(heuristic),
+        getClosedEntries<ClosedChainingList>(closed_size.capacity,
+                                             closed_size.memory_budget_mb));
+  } else if (search_string == "astar_pool") {
+    return std::make_unique<AStarPool<Heuristic>>(
+        std::move(heuristic),
+        getClosedEntries<ClosedPoolList>(closed_size.capacity,
+                                         closed_size.memory_budget_mb));
+  } else if (search_string == "astar_compact") {
+    return std::make_unique<AStarCompact<Heuristic>>(
+        std::move(heuristic),
+        getClosedEntries<ClosedCompactList>(closed_size.capacity,
+                                            closed_size.memory_budget_mb));
+  } else if (search_string == "astar_swiss") {
+    return std::make_unique<AStarSwiss<Heuristic>>(
+        std::move(heuristic),
+        getClosedEntries<ClosedSwissList>(closed_size.capacity,
+                                          closed_size.memory_budget_mb));
+  } else if (search_string == "astar_robin_hood") {
+    return std::make_unique<AStarRobinHood<Heuristic>>(
+        std::move(heuristic),
+        getClosedEntries<ClosedRobinHoodList>(closed_size.capacity,
+                                              closed_size.memory_budget_mb));
+  } else if (search_string == "astar_resizable") {
+    return std::make_unique<AStarResizable<Heuristic>>(std::move(heuristic));
+  } else if (search_string == "idastar") {
+    return std::make_unique<IDAStar<Node, Heuristic>>(std::move(heuristic));
+  } else if (search_string == "idastar_in_place") {
+    return std::make_unique<InPlaceIDAStar<Node, Heuristic>>(
+        std::move(heuristic));
+  }
+  return nullptr;
+}
+
+// returns search algorithm using pattern database heuristic, loaded from
+// pdb_files_string if not empty, otherwise built for partition_string
+template <typename Storage>
+std::unique_ptr<Search<Node>>
+makePatternDatabaseSearch(std::string const &search_string,
+                          std::string const &partition_string,
+                          std::string const &pdb_files_string,
+                          ClosedSize const &closed_size) {
+  using Heuristic = PatternDatabaseHeuristic<WIDTH, HEIGHT, Storage>;
+  if (!pdb_files_string.empty()) {
+    return makeSearch(search_string, Heuristic::load(pdb_files_string),
+                      closed_size);
+  }
+  auto partition = partition_string.empty()
+                       ? getDefaultPartition<WIDTH, HEIGHT>()
+                       : getPartitionFromString(partition_string);
+  return makeSearch(search_string, Heuristic(partition), closed_size);
+}
+
 int main(int argc, char *argv[]) {
 
   cxxopts::Options options(
@@ -49,9 +147,35 @@ int main(int argc, char *argv[]) {
       "goal state configuration "
       "e.g. \"1 2 3 7 4 5 6 0 8 9 10 11 12 13 14 15\"",
       cxxopts::value<std::string>()->default_value(""))(
-      "s,search_algorithm", "search algorithm [astar, astar_pool, idastar]",
-      cxxopts::value<std::string>()->default_value("astar"))("h,help",
-                                                             "print help");
+      "s,search_algorithm",
+      "search algorithm [astar, astar_pool, astar_compact, astar_swiss, "
+      "astar_robin_hood, astar_resizable, idastar, idastar_in_place]",
+      cxxopts::value<std::string>()->default_value("astar"))(
+      "e,heuristic", "heuristic [manhattan, linear_conflict, walking_distance, pdb]",
+      cxxopts::value<std::string>()->default_value("manhattan"))(
+      "p,partition",
+      "pattern database partition [663, 78, 6666] or groups of tiles "
+      "e.g. \"1 2 3 4 5 6 7, 8 9 10 11 12 13 14 15\", "
+      "default 663 for the 15 puzzle, 6666 for the 24 puzzle",
+      cxxopts::value<std::string>()->default_value(""))(
+      "f,pdb_files",
+      "comma separated pattern database files built by PDBBuilder, memory "
+      "mapped instead of building the partition",
+      cxxopts::value<std::string>()->default_value(""))(
+      "c,pdb_storage",
+      "pattern database storage [byte, nibble, mod3], nibble stores 4 bits "
+      "per entry, mod3 stores 2 bits per entry and evaluates children "
+      "incrementally",
+      cxxopts::value<std::string>()->default_value("byte"))(
+      "closed_capacity", "number of closed list entries of astar searches",
+      cxxopts::value<size_t>()->default_value(std::to_string(ClosedEntries)))(
+      "memory_budget",
+      "closed list memory in MB of astar searches, overrides closed_capacity",
+      cxxopts::value<size_t>()->default_value("0"))(
+      "seed", "seed of hash functions, same seed gives same hash values",
+      cxxopts::value<uint64_t>()->default_value(
+          std::to_string(std::mt19937_64::default_seed)))(
+      "h,help", "print help");
 
   // parse command line
   auto result = options.parse(argc, argv);
@@ -65,6 +189,11 @@ int main(int argc, char *argv[]) {
   auto goal_tiles_string = result["goal_state"].as<std::string>();
 
   try {
+    // seed hash functions before constructing nodes
+    auto seed = result["seed"].as<uint64_t>();
+    Node::seedHash(seed);
+    TabulationHash<Node, N_TILES>::seed(seed);
+
     // read initial tiles
     // for generic node perhaps modify constructor to take in string
     auto initial_node = Node(getBoardFromString<N_TILES>(initial_tiles_string));
@@ -79,13 +208,49 @@ int main(int argc, char *argv[]) {
     auto timer = SteadyClockTimer();
     timer.start();
 
-    if (search_string == "astar") {
-      search_algo = std::make_unique<DefaultAStar>();
-    } else if (search_string == "astar_pool") {
-      search_algo = std::make_unique<AStarPool>();
-    } else if (search_string == "idastar") {
-      search_algo = std::make_unique<IDAStar<Node, Heuristic>>();
+    // heuristic
+    auto heuristic_string = result["heuristic"].as<std::string>();
+    auto partition_string = result["partition"].as<std::string>();
+    auto pdb_files_string = result["pdb_files"].as<std::string>();
+    auto pdb_storage_string = result["pdb_storage"].as<std::string>();
+    ClosedSize closed_size;
+    closed_size.capacity = result["closed_capacity"].as<size_t>();
+    closed_size.memory_budget_mb = result["memory_budget"].as<size_t>();
+
+    if (heuristic_string == "manhattan") {
+      search_algo = makeSearch(search_string,
+                               ManhattanDistanceHeuristic<WIDTH, HEIGHT>(),
+                               closed_size);
+    } else if (heuristic_string == "linear_conflict") {
+      search_algo = makeSearch(search_string,
+                               LinearConflictHeuristic<WIDTH, HEIGHT>(),
+                               closed_size);
+    } else if (heuristic_string == "walking_distance") {
+      search_algo = makeSearch(search_string,
+                               WalkingDistanceHeuristic<WIDTH, HEIGHT>(),
+                               closed_size);
+    } else if (heuristic_string == "pdb") {
+      if (pdb_storage_string == "byte") {
+        search_algo = makePatternDatabaseSearch<ByteStorage>(
+            search_string, partition_string, pdb_files_string, closed_size);
+      } else if (pdb_storage_string == "nibble") {
+        search_algo = makePatternDatabaseSearch<NibbleStorage>(
+            search_string, partition_string, pdb_files_string, closed_size);
+      } else if (pdb_storage_string == "mod3") {
+        search_algo = makePatternDatabaseSearch<Mod3Storage>(
+            search_string, partition_string, pdb_files_string, closed_size);
+      } else {
+        std::cerr << "Invalid pattern database storage option: "
+                  << "\"" << pdb_storage_string << "\"\n";
+        return EXIT_FAILURE;
+      }
     } else {
+      std::cerr << "Invalid heuristic option: "
+                << "\"" << heuristic_string << "\"\n";
+      return EXIT_FAILURE;
+    }
+
+    if (!search_algo) {
       std::cerr << "Invalid search algorithm option: "
                 << "\"" << search_string << "\"\n";
       return EXIT_FAILURE;
@@ -98,7 +263,8 @@ int main(int argc, char *argv[]) {
     std::cout << timer.getElapsedTime<milliseconds>()
               << " ms to solve (including initialization)\n"
               << *search_algo << "\n"
-              << "n moves: " << path.size() - 1 << "\n"
+              << "n moves: " << (path.empty() ? -1 : getG(path.back()))
+              << "\n"
               << "sequence:\n";
     for (auto node : path) {
       std::cout << node << "\n";
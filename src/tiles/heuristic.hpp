@@ -0,0 +1,62 @@
+#ifndef HEURISTIC_HPP
+#define HEURISTIC_HPP
+
+#include <cstdint>
+#include "tile_node.hpp"
+
+namespace Tiles {
+
+    /* Heuristics implement, for each node type they support:
+     * evalH(node): full evaluation, for initial nodes
+     * evalChild(parent, child): evaluation of child generated from parent by
+     * one move, usually updating the value of the parent in constant time
+     * evalHIncremental(node): evaluation of node after a move applied in
+     * place, node holds the value before the move
+     */
+
+    // evaluate heuristic value of node, entry point for search algorithms
+    template<template <int, int> class NodeType, int WIDTH, int HEIGHT,
+             typename Heuristic>
+    void evalH(NodeType<WIDTH, HEIGHT> & node, Heuristic const & heuristic) noexcept {
+        heuristic.evalH(node);
+    }
+
+    // evaluate heuristic value of child generated from parent, entry point
+    // for search algorithms
+    template<template <int, int> class NodeType, int WIDTH, int HEIGHT,
+             typename Heuristic>
+    void evalChild(NodeType<WIDTH, HEIGHT> const & parent,
+                   NodeType<WIDTH, HEIGHT> & child,
+                   Heuristic const & heuristic) noexcept {
+        heuristic.evalChild(parent, child);
+    }
+
+    // evaluate heuristic value of node after a move applied in place (see
+    // applyMove of nodes), entry point for in place search algorithms
+    template<template <int, int> class NodeType, int WIDTH, int HEIGHT,
+             typename Heuristic>
+    void evalMoved(NodeType<WIDTH, HEIGHT> & node,
+                   Heuristic const & heuristic) noexcept {
+        heuristic.evalHIncremental(node);
+    }
+
+    // index of blank in parent of node, for incremental heuristics
+    template<template <int, int> class NodeType, int WIDTH, int HEIGHT>
+    uint8_t getParentBlankIdx(NodeType<WIDTH, HEIGHT> const & node) noexcept {
+        switch(node.prev_move) {
+        case UP:
+            return node.blank_idx + WIDTH;
+        case DOWN:
+            return node.blank_idx - WIDTH;
+        case LEFT:
+            return node.blank_idx + 1;
+        case RIGHT:
+            return node.blank_idx - 1;
+        default:
+            break;
+        }
+        return node.blank_idx;
+    }
+}
+
+#endif
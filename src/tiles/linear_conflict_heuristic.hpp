@@ -0,0 +1,179 @@
+#ifndef LINEAR_CONFLICT_HEURISTIC_HPP
+#define LINEAR_CONFLICT_HEURISTIC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "heuristic.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "tile_node.hpp"
+
+namespace Tiles {
+
+    // base^exponent, for sizes of line tables
+    constexpr int getPower(int base, int exponent) noexcept {
+        return exponent == 0 ? 1 : base * getPower(base, exponent - 1);
+    }
+
+    // moves added by conflicts in a line of length cells, key holds for
+    // each cell (least significant first) the goal position in the line of
+    // its tile, or length if the tile does not belong to the line.
+    // Tiles outside the longest increasing subsequence of goal positions
+    // must leave the line and come back, 2 moves each
+    inline uint8_t getLineConflicts(int key, int length) noexcept {
+        std::vector<int> goal_positions;
+        for (int cell = 0; cell < length; ++cell) {
+            int digit = key % (length + 1);
+            key /= (length + 1);
+            if (digit != length) goal_positions.push_back(digit);
+        }
+        // longest[i] is length of longest increasing subsequence ending at i
+        std::vector<int> longest(goal_positions.size(), 1);
+        int longest_increasing = 0;
+        for (size_t i = 0; i < goal_positions.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (goal_positions[j] < goal_positions[i]) {
+                    longest[i] = std::max(longest[i], longest[j] + 1);
+                }
+            }
+            longest_increasing = std::max(longest_increasing, longest[i]);
+        }
+        return 2 * (goal_positions.size() - longest_increasing);
+    }
+
+    /* Manhattan distance plus linear conflicts of rows and columns.
+     * The key of a line is the sum over its cells of a precomputed part per
+     * tile and cell, conflicts of a line are a lookup of its key.
+     * The goal places tile i at index i, as in ManhattanDistanceHeuristic.
+     */
+    template<int WIDTH, int HEIGHT>
+    struct LinearConflictHeuristic {
+        static int const N_TILES = WIDTH*HEIGHT;
+        static int const N_ROW_KEYS = getPower(WIDTH + 1, WIDTH);
+        static int const N_COL_KEYS = getPower(HEIGHT + 1, HEIGHT);
+
+        ManhattanDistanceHeuristic<WIDTH, HEIGHT> manhattan;
+
+        // part of key of row (column) of each tile at each index
+        std::array< std::array<uint16_t, N_TILES>, N_TILES> row_parts;
+        std::array< std::array<uint16_t, N_TILES>, N_TILES> col_parts;
+
+        // conflicts of row (column), indexed by key
+        std::array<uint8_t, N_ROW_KEYS> row_conflicts;
+        std::array<uint8_t, N_COL_KEYS> col_conflicts;
+
+        LinearConflictHeuristic() {
+            for (int tile = 0; tile < N_TILES; ++tile) {
+                for (int idx = 0; idx < N_TILES; ++idx) {
+                    int row = idx / WIDTH;
+                    int col = idx % WIDTH;
+                    // blank belongs to no line
+                    bool in_goal_row = tile != 0 && tile / WIDTH == row;
+                    bool in_goal_col = tile != 0 && tile % WIDTH == col;
+                    row_parts[tile][idx] = (in_goal_row ? tile % WIDTH : WIDTH) *
+                        getPower(WIDTH + 1, col);
+                    col_parts[tile][idx] = (in_goal_col ? tile / WIDTH : HEIGHT) *
+                        getPower(HEIGHT + 1, row);
+                }
+            }
+            for (int key = 0; key < N_ROW_KEYS; ++key) {
+                row_conflicts[key] = getLineConflicts(key, WIDTH);
+            }
+            for (int key = 0; key < N_COL_KEYS; ++key) {
+                col_conflicts[key] = getLineConflicts(key, HEIGHT);
+            }
+        }
+
+        template <typename Node>
+        int getRowKey(Node const & node, int row) const noexcept {
+            int key = 0;
+            for (int idx = row * WIDTH; idx < (row + 1) * WIDTH; ++idx) {
+                key += row_parts[node.board[idx]][idx];
+            }
+            return key;
+        }
+
+        template <typename Node>
+        int getColKey(Node const & node, int col) const noexcept {
+            int key = 0;
+            for (int idx = col; idx < N_TILES; idx += WIDTH) {
+                key += col_parts[node.board[idx]][idx];
+            }
+            return key;
+        }
+
+        template <typename Node>
+        void evalH(Node & node) const noexcept {
+            std::array<int, HEIGHT> row_keys{};
+            std::array<int, WIDTH> col_keys{};
+            int idx = 0;
+            for (auto tile : node) {
+                row_keys[idx / WIDTH] += row_parts[tile][idx];
+                col_keys[idx % WIDTH] += col_parts[tile][idx];
+                ++idx;
+            }
+            int heuristic_value = 0;
+            for (auto key : row_keys) {
+                heuristic_value += row_conflicts[key];
+            }
+            for (auto key : col_keys) {
+                heuristic_value += col_conflicts[key];
+            }
+            manhattan.evalH(node);
+            node.h_val += heuristic_value;
+        }
+
+        // node holds heuristic value of parent; only the line the tile moved
+        // along and the two lines it moved between change
+        template <typename Node>
+        void evalHIncremental(Node & node) const noexcept {
+            auto new_idx = getParentBlankIdx(node); // cell the tile moved to
+            auto old_idx = node.blank_idx;          // cell the tile moved from
+            auto tile = node.board[new_idx];
+            manhattan.evalHIncremental(node);
+
+            int delta = 0;
+            // key of parent line from key of child line
+            auto rowDelta = [&](int row) {
+                auto key = getRowKey(node, row);
+                auto parent_key = key;
+                if (old_idx / WIDTH == row) {
+                    parent_key += row_parts[tile][old_idx] - row_parts[0][old_idx];
+                }
+                if (new_idx / WIDTH == row) {
+                    parent_key += row_parts[0][new_idx] - row_parts[tile][new_idx];
+                }
+                return row_conflicts[key] - row_conflicts[parent_key];
+            };
+            auto colDelta = [&](int col) {
+                auto key = getColKey(node, col);
+                auto parent_key = key;
+                if (old_idx % WIDTH == col) {
+                    parent_key += col_parts[tile][old_idx] - col_parts[0][old_idx];
+                }
+                if (new_idx % WIDTH == col) {
+                    parent_key += col_parts[0][new_idx] - col_parts[tile][new_idx];
+                }
+                return col_conflicts[key] - col_conflicts[parent_key];
+            };
+
+            if (old_idx / WIDTH == new_idx / WIDTH) { // moved along row
+                delta += rowDelta(old_idx / WIDTH);
+                delta += colDelta(old_idx % WIDTH) + colDelta(new_idx % WIDTH);
+            } else {                                  // moved along column
+                delta += colDelta(old_idx % WIDTH);
+                delta += rowDelta(old_idx / WIDTH) + rowDelta(new_idx / WIDTH);
+            }
+            node.h_val += delta;
+        }
+
+        template <typename Node>
+        void evalChild(Node const & parent, Node & child) const noexcept {
+            child.h_val = parent.h_val;
+            evalHIncremental(child);
+        }
+    };
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <cstdlib>
 #include <array>
+#include "heuristic.hpp"
 #include "tile_node.hpp"
 
 namespace Tiles {
@@ -41,7 +42,8 @@ namespace Tiles {
             }
         }
 
-        void evalH(TileNode<WIDTH, HEIGHT> & node) const noexcept {
+        template <typename Node>
+        void evalH(Node & node) const noexcept {
             int heuristic_value = 0;
             for (int idx = 0; idx < WIDTH*HEIGHT; ++idx) {
                 heuristic_value += table[node.board[idx]][idx];
@@ -49,37 +51,20 @@ namespace Tiles {
             node.h_val = heuristic_value;
         }
 
-        void evalHIncremental(TileNode<WIDTH, HEIGHT> & node) const noexcept {
+        template <typename Node>
+        void evalHIncremental(Node & node) const noexcept {
             auto parent_blank_idx = getParentBlankIdx(node);
             auto tile_moved = node.board[parent_blank_idx];
             node.h_val += (table[tile_moved][parent_blank_idx] -
                            table[tile_moved][node.blank_idx]);
         }
-    };
 
-    // helper function for incremental manhattan heuristic
-    template<int WIDTH, int HEIGHT>
-    uint8_t getParentBlankIdx(TileNode<WIDTH, HEIGHT> const & node) noexcept {
-        switch(node.prev_move) {
-        case UP:
-            return node.blank_idx + WIDTH;
-        case DOWN:
-            return node.blank_idx - WIDTH;
-        case LEFT:
-            return node.blank_idx + 1;
-        case RIGHT:
-            return node.blank_idx - 1;
-        default:
-            break;
+        template <typename Node>
+        void evalChild(Node const & parent, Node & child) const noexcept {
+            child.h_val = parent.h_val;
+            evalHIncremental(child);
         }
-        return node.blank_idx;
-    }
-
-    // use non incremental heuristic as optimization seems to give minimal speedup
-    template<int WIDTH, int HEIGHT, typename Heuristic>
-    void evalH(TileNode<WIDTH, HEIGHT> & node, Heuristic const & heuristic) noexcept {
-        heuristic.evalH(node);
-    }
+    };
 }
 
 #endif
@@ -0,0 +1,420 @@
+#ifndef PACKED_TILE_NODE_HPP
+#define PACKED_TILE_NODE_HPP
+
+#include "tile_node.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Tiles {
+
+__extension__ typedef unsigned __int128 uint128_t;
+
+// storage of packed board
+template <typename Word> struct PackedWord { Word word = 0; };
+
+// 128 bit boards are only aligned to 4 bytes so that node metadata does not
+// pad the node out to 32 bytes
+template <> struct __attribute__((packed, aligned(4))) PackedWord<uint128_t> {
+  uint128_t word = 0;
+};
+
+// smallest number of bits per tile and word type that fits the board
+template <int N_TILES> struct PackedBoardTraits {
+  static constexpr int BITS = N_TILES <= 16 ? 4 : 5;
+  static_assert(N_TILES * BITS <= 128, "board does not fit in 128 bits");
+  using Word =
+      std::conditional_t<N_TILES * BITS <= 64, uint64_t, uint128_t>;
+};
+
+// placeholder for a hash value that is not cached
+struct NoHashValue {};
+
+// tile values packed into a single integer word, BITS bits per tile,
+// tile at index i is stored in bits [i * BITS, (i + 1) * BITS)
+template <int N_TILES, int BITS, typename Word>
+struct PackedBoard : PackedWord<Word> {
+
+  static constexpr Word MASK = (Word(1) << BITS) - 1;
+
+  using PackedWord<Word>::word;
+
+  // get tile at index
+  uint8_t operator[](int idx) const noexcept {
+    return static_cast<uint8_t>((word >> (idx * BITS)) & MASK);
+  }
+
+  // set tile at index
+  void set(int idx, uint8_t tile) noexcept {
+    word = (word & ~(MASK << (idx * BITS))) | (Word(tile) << (idx * BITS));
+  }
+
+  // move tile at from_idx into to_idx, to_idx must hold the blank (0)
+  void slide(int from_idx, int to_idx) noexcept {
+    word |= ((word >> (from_idx * BITS)) & MASK) << (to_idx * BITS);
+    word &= ~(MASK << (from_idx * BITS));
+  }
+
+  // read only iterator, unpacks tiles by shifting
+  class const_iterator {
+    Word word = 0;
+    int idx = 0;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = uint8_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = uint8_t const *;
+    using reference = uint8_t;
+
+    const_iterator() = default;
+    const_iterator(Word word, int idx) : word(word), idx(idx) {}
+
+    uint8_t operator*() const noexcept {
+      return static_cast<uint8_t>(word & MASK);
+    }
+    const_iterator &operator++() noexcept {
+      word >>= BITS;
+      ++idx;
+      return *this;
+    }
+    const_iterator operator++(int) noexcept {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(const_iterator const &rhs) const noexcept {
+      return idx == rhs.idx;
+    }
+    bool operator!=(const_iterator const &rhs) const noexcept {
+      return idx != rhs.idx;
+    }
+  };
+
+  using value_type = uint8_t;
+  using iterator = const_iterator;
+
+  const_iterator begin() const noexcept { return const_iterator(word, 0); }
+  const_iterator end() const noexcept { return const_iterator(0, N_TILES); }
+  static constexpr size_t size() noexcept { return N_TILES; }
+};
+
+template <int N_TILES, int BITS, typename Word>
+bool operator==(PackedBoard<N_TILES, BITS, Word> const &lhs,
+                PackedBoard<N_TILES, BITS, Word> const &rhs) noexcept {
+  return lhs.word == rhs.word;
+}
+
+template <int N_TILES, int BITS, typename Word>
+bool operator!=(PackedBoard<N_TILES, BITS, Word> const &lhs,
+                PackedBoard<N_TILES, BITS, Word> const &rhs) noexcept {
+  return lhs.word != rhs.word;
+}
+
+/* Tile node with board packed into a single word.
+ * Boards of up to 16 tiles use a 64 bit word with 4 bits per tile (16 byte
+ * node for the 15 puzzle), boards of up to 25 tiles use a 128 bit word with 5
+ * bits per tile (20 byte node for the 24 puzzle).
+ * Same interface as TileNode, equality, hashing and copying work on one word
+ * instead of N_TILES bytes.
+ * The Zobrist hash value of the board is cached in the padding of 16 byte
+ * nodes and updated when the blank moves, 24 puzzle nodes have no padding
+ * and compute it when needed (see getHash).
+ */
+template <int WIDTH, int HEIGHT> struct PackedTileNode {
+
+  static int const N_TILES = WIDTH * HEIGHT;
+
+  using Board = PackedBoard<N_TILES, PackedBoardTraits<N_TILES>::BITS,
+                            typename PackedBoardTraits<N_TILES>::Word>;
+
+  // goal board configuration
+  static PackedTileNode<WIDTH, HEIGHT> goal_node;
+
+  // tile values, indexed in row-major order
+  Board board;
+
+  // index of blank
+  uint8_t blank_idx = std::numeric_limits<uint8_t>::max();
+
+  // caching to prevent regeneration of parent node
+  MOVE prev_move = NONE;
+
+  // cost and heuristic value of node
+  uint8_t g_val = 0;
+  uint8_t h_val = std::numeric_limits<uint8_t>::max();
+
+  static constexpr bool CACHES_HASH = sizeof(Board) == sizeof(uint64_t);
+
+  // Zobrist hash value of board, if cached
+  [[no_unique_address]] std::conditional_t<CACHES_HASH, ZobristValue<N_TILES>,
+                                           NoHashValue> hash_val{};
+
+  PackedTileNode() = default; // sentinel value;
+
+  // construct node from array of tiles
+  PackedTileNode(std::array<uint8_t, N_TILES> const &tiles) {
+    if (!isValidBoard<WIDTH, HEIGHT>(tiles)) {
+      throw std::invalid_argument("invalid initial board configuration");
+    }
+    for (int idx = 0; idx < N_TILES; ++idx) {
+      board.set(idx, tiles[idx]);
+      if (tiles[idx] == 0) {
+        blank_idx = idx;
+      }
+    }
+    if constexpr (CACHES_HASH) {
+      hash_val = ZobristTable<N_TILES>::get().hash(board);
+    }
+  }
+
+  static void setGoalBoard(std::array<uint8_t, N_TILES> goal_board) {
+    goal_node = PackedTileNode<WIDTH, HEIGHT>(goal_board);
+  }
+
+  // reseed Zobrist hash table (see ZobristTable::seed) and rehash the goal
+  // node, before constructing other nodes
+  static void seedHash(uint64_t seed) {
+    ZobristTable<N_TILES>::seed(seed);
+    if constexpr (CACHES_HASH) {
+      goal_node.hash_val = ZobristTable<N_TILES>::get().hash(goal_node.board);
+    }
+  }
+
+  // get index of current blank tile
+  uint8_t getBlankIdx() const noexcept { return blank_idx; }
+
+  // slide tile at from_idx into the blank at to_idx, updating hash value
+  void slide(int from_idx, int to_idx) noexcept {
+    if constexpr (CACHES_HASH) {
+      hash_val = ZobristTable<N_TILES>::get().move(hash_val, board[from_idx],
+                                                   from_idx, to_idx);
+    }
+    board.slide(from_idx, to_idx);
+  }
+
+  // swap blank tile with new blank tile to get new tile node
+  PackedTileNode<WIDTH, HEIGHT> swapBlank(uint8_t new_blank_idx) const
+      noexcept {
+    auto new_node = *this; // copy
+    new_node.slide(new_blank_idx, blank_idx);
+    new_node.blank_idx = new_blank_idx; // cache blank idx
+    return new_node;
+  }
+
+  // get new node from moving blank in direction move
+  // cache previous move and increments g_val
+  std::optional<PackedTileNode<WIDTH, HEIGHT>> moveBlank(MOVE move) const
+      noexcept {
+    std::optional<PackedTileNode<WIDTH, HEIGHT>> new_node;
+    auto new_blank_idx = getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, move);
+    if (new_blank_idx >= 0) {
+      new_node.emplace(swapBlank(new_blank_idx));
+      new_node->prev_move = move; // cache previous move
+      ++new_node->g_val;          // increment g value
+    }
+    return new_node;
+  }
+
+  // move blank in direction move in place, cache previous move and
+  // increments g_val, returns false (node unchanged) if the blank would be
+  // moved off the board
+  bool applyMove(MOVE move) noexcept {
+    auto new_blank_idx = getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, move);
+    if (new_blank_idx < 0) {
+      return false;
+    }
+    slide(new_blank_idx, blank_idx);
+    blank_idx = new_blank_idx;
+    prev_move = move;
+    ++g_val;
+    return true;
+  }
+
+  // undo applyMove(move), restoring previous move and heuristic value
+  void undoMove(MOVE move, MOVE old_prev_move, uint8_t old_h_val) noexcept {
+    auto old_blank_idx =
+        getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, getInverseMove(move));
+    slide(old_blank_idx, blank_idx);
+    blank_idx = old_blank_idx;
+    prev_move = old_prev_move;
+    --g_val;
+    h_val = old_h_val;
+  }
+
+  // simple iterator
+  using const_iterator = typename Board::const_iterator;
+
+  const_iterator begin() const noexcept { return board.begin(); }
+  const_iterator end() const noexcept { return board.end(); }
+};
+
+// static initialization of goal node
+template <int WIDTH, int HEIGHT>
+PackedTileNode<WIDTH, HEIGHT> PackedTileNode<WIDTH, HEIGHT>::goal_node =
+    PackedTileNode<WIDTH, HEIGHT>(getGoalBoard<WIDTH, HEIGHT>());
+
+// free functions, loose coupling, take advantage of argument dependent
+// lookup
+
+template <int WIDTH, int HEIGHT>
+bool operator==(PackedTileNode<WIDTH, HEIGHT> const &lhs,
+                PackedTileNode<WIDTH, HEIGHT> const &rhs) noexcept {
+  return lhs.board == rhs.board;
+}
+
+// packed board identifying the state of node, never zero as a board holds
+// distinct tiles
+template <int WIDTH, int HEIGHT>
+auto getKey(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  return node.board.word;
+}
+
+// get Zobrist hash value of board, cached for boards of up to 16 tiles
+template <int WIDTH, int HEIGHT>
+ZobristValue<WIDTH * HEIGHT>
+getHash(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  if constexpr (PackedTileNode<WIDTH, HEIGHT>::CACHES_HASH) {
+    return node.hash_val;
+  } else {
+    return ZobristTable<WIDTH * HEIGHT>::get().hash(node.board);
+  }
+}
+
+// get cost of path to node
+template <int WIDTH, int HEIGHT>
+int getG(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  return static_cast<int>(node.g_val);
+}
+
+// get heuristic value of node
+template <int WIDTH, int HEIGHT>
+int getH(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  return static_cast<int>(node.h_val);
+}
+
+// get g + h value
+template <int WIDTH, int HEIGHT>
+int getF(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  return getG(node) + getH(node);
+}
+
+// check if node is goal node
+template <int WIDTH, int HEIGHT>
+bool isGoal(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  return node == node.goal_node;
+}
+
+// get nodes that can be generated from current node
+template <int WIDTH, int HEIGHT>
+std::array<std::optional<PackedTileNode<WIDTH, HEIGHT>>, N_MOVES>
+getChildNodes(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  std::array<std::optional<PackedTileNode<WIDTH, HEIGHT>>, N_MOVES>
+      child_nodes;
+  if (node.prev_move != UP) {
+    child_nodes[DOWN] = node.moveBlank(DOWN);
+  }
+  if (node.prev_move != RIGHT) {
+    child_nodes[LEFT] = node.moveBlank(LEFT);
+  }
+  if (node.prev_move != LEFT) {
+    child_nodes[RIGHT] = node.moveBlank(RIGHT);
+  }
+  if (node.prev_move != DOWN) {
+    child_nodes[UP] = node.moveBlank(UP);
+  }
+  return child_nodes;
+}
+
+// moves of blank, in the order children are generated
+template <int WIDTH, int HEIGHT>
+constexpr std::array<MOVE, N_MOVES>
+getMoves(PackedTileNode<WIDTH, HEIGHT> const &) noexcept {
+  return {DOWN, LEFT, RIGHT, UP};
+}
+
+// move blank of node in place, unless the blank would be moved off the board
+// or the move undoes the previous move (as in getChildNodes), returns whether
+// node was moved
+template <int WIDTH, int HEIGHT>
+bool applyMove(PackedTileNode<WIDTH, HEIGHT> &node, MOVE move) noexcept {
+  if (node.prev_move == getInverseMove(move)) {
+    return false;
+  }
+  return node.applyMove(move);
+}
+
+// undo applyMove(node, move), restoring previous move and heuristic value
+template <int WIDTH, int HEIGHT>
+void undoMove(PackedTileNode<WIDTH, HEIGHT> &node, MOVE move, MOVE prev_move,
+              uint8_t h_val) noexcept {
+  node.undoMove(move, prev_move, h_val);
+}
+
+template <int WIDTH, int HEIGHT>
+std::optional<PackedTileNode<WIDTH, HEIGHT>>
+getParent(PackedTileNode<WIDTH, HEIGHT> const &node) noexcept {
+  if (node.prev_move == UP) {
+    return node.moveBlank(DOWN);
+  }
+  if (node.prev_move == DOWN) {
+    return node.moveBlank(UP);
+  }
+  if (node.prev_move == LEFT) {
+    return node.moveBlank(RIGHT);
+  }
+  if (node.prev_move == RIGHT) {
+    return node.moveBlank(LEFT);
+  }
+  return {};
+}
+
+// pretty print board
+template <int WIDTH, int HEIGHT>
+std::ostream &operator<<(std::ostream &os,
+                         PackedTileNode<WIDTH, HEIGHT> const &node) {
+  for (int row = 0; row < HEIGHT; ++row) {
+    for (int col = 0; col < WIDTH; ++col) {
+      os << std::setw(2) << static_cast<int>(node.board[row * WIDTH + col])
+         << " ";
+    }
+    os << "\n";
+  }
+  return os;
+}
+} // namespace Tiles
+
+// overload default hash
+namespace std {
+template <int WIDTH, int HEIGHT>
+struct hash<Tiles::PackedTileNode<WIDTH, HEIGHT>> {
+
+  // packed board is a permutation, mix bits so that low bits are well
+  // distributed (splitmix64 finalizer)
+  static uint64_t mix(uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+  }
+
+  size_t operator()(const Tiles::PackedTileNode<WIDTH, HEIGHT> &node) const
+      noexcept {
+    auto word = node.board.word;
+    if constexpr (sizeof(word) > sizeof(uint64_t)) {
+      return mix(static_cast<uint64_t>(word) ^
+                 mix(static_cast<uint64_t>(word >> 64)));
+    } else {
+      return mix(word);
+    }
+  }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef PATTERN_DATABASE_BUILDER_HPP
+#define PATTERN_DATABASE_BUILDER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "tile_node.hpp"
+
+namespace Tiles {
+
+    // number of ways to place n_placed distinct tiles on n_cells cells
+    inline size_t nPlacements(int n_cells, int n_placed) noexcept {
+        size_t n = 1;
+        for (int i = 0; i < n_placed; ++i) {
+            n *= n_cells - i;
+        }
+        return n;
+    }
+
+    // perfect hash of the cells occupied by n_placed distinct tiles,
+    // in [0, nPlacements(n_cells, n_placed)), first tile most significant
+    inline size_t rankPlacement(uint8_t const * cells, int n_placed,
+                                int n_cells) noexcept {
+        size_t rank = 0;
+        for (int i = 0; i < n_placed; ++i) {
+            // number of free cells before this cell
+            int digit = cells[i];
+            for (int j = 0; j < i; ++j) {
+                digit -= cells[j] < cells[i];
+            }
+            rank = rank * (n_cells - i) + digit;
+        }
+        return rank;
+    }
+
+    // inverse of rankPlacement
+    inline void unrankPlacement(size_t rank, int n_placed, int n_cells,
+                                uint8_t * cells) noexcept {
+        for (int i = n_placed - 1; i >= 0; --i) {
+            cells[i] = rank % (n_cells - i);
+            rank /= (n_cells - i);
+        }
+        uint32_t free_cells = (n_cells == 32) ? ~0u : (1u << n_cells) - 1;
+        for (int i = 0; i < n_placed; ++i) {
+            // digit-th free cell, clear lower free cells
+            auto candidates = free_cells;
+            for (int digit = cells[i]; digit > 0; --digit) {
+                candidates &= candidates - 1;
+            }
+            cells[i] = __builtin_ctz(candidates);
+            free_cells &= ~(1u << cells[i]);
+        }
+    }
+
+    /* Search frontier of the pattern database builder.
+     * 2 bit code per state, 32 states per word, codes are changed with
+     * compare and swap so that threads can claim states concurrently.
+     */
+    class PatternFrontier {
+    public:
+        enum Code : unsigned { UNSEEN = 0, CURRENT = 1, NEXT = 2, CLOSED = 3 };
+
+        static int const STATES_PER_WORD = 32;
+
+        explicit PatternFrontier(size_t n_states)
+            : words((n_states + STATES_PER_WORD - 1) / STATES_PER_WORD) {}
+
+        size_t nWords() const noexcept { return words.size(); }
+
+        Code get(size_t state) const noexcept {
+            auto word = words[state / STATES_PER_WORD].load(std::memory_order_relaxed);
+            return static_cast<Code>((word >> shift(state)) & 3);
+        }
+
+        // set code of state to to_code if its code is one of from_codes
+        // (bitmask of codes), returns false if it is not
+        bool transition(size_t state, unsigned from_codes, Code to_code) noexcept {
+            auto & word = words[state / STATES_PER_WORD];
+            auto old_word = word.load(std::memory_order_relaxed);
+            uint64_t new_word;
+            do {
+                auto code = (old_word >> shift(state)) & 3;
+                if (!(from_codes & (1u << code))) return false;
+                new_word = (old_word & ~(uint64_t(3) << shift(state))) |
+                    (uint64_t(to_code) << shift(state));
+            } while (!word.compare_exchange_weak(old_word, new_word,
+                                                 std::memory_order_relaxed));
+            return true;
+        }
+
+        // low bit of each code of word set if state is CURRENT
+        uint64_t getCurrentMask(size_t word_idx) const noexcept {
+            auto word = words[word_idx].load(std::memory_order_relaxed);
+            return word & ~(word >> 1) & LOW_BITS;
+        }
+
+        // turn NEXT states of word into CURRENT states, returns their number
+        int advance(size_t word_idx) noexcept {
+            auto word = words[word_idx].load(std::memory_order_relaxed);
+            uint64_t next = (word >> 1) & ~word & LOW_BITS;
+            words[word_idx].store(word ^ (next | (next << 1)),
+                                  std::memory_order_relaxed);
+            return __builtin_popcountll(next);
+        }
+
+    private:
+        static constexpr uint64_t LOW_BITS = 0x5555555555555555ULL;
+
+        static int shift(size_t state) noexcept {
+            return 2 * (state % STATES_PER_WORD);
+        }
+
+        std::vector< std::atomic<uint64_t> > words;
+    };
+
+    // run function(thread_id) on n_threads threads and wait for all of them
+    template<typename Function>
+    void runThreads(int n_threads, Function function) {
+        std::vector<std::thread> threads;
+        for (int thread_id = 0; thread_id < n_threads; ++thread_id) {
+            threads.emplace_back(function, thread_id);
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+
+    /* State space searched for pattern database values.
+     * WITH_BLANK: pattern tiles and blank, a pattern tile moves into the
+     * blank, the value of pattern cells is the minimum over blank cells.
+     * Larger values, but not consistent: a move can decrease the value of
+     * a pattern by more than 1.
+     * WITHOUT_BLANK: pattern tiles only, a pattern tile moves to any
+     * adjacent cell free of pattern tiles. Every move changes the value of
+     * a pattern by at most 1 (consistent).
+     */
+    enum class PatternSpace : uint8_t { WITH_BLANK = 0, WITHOUT_BLANK = 1 };
+
+    /* Build pattern database of pattern tiles with n_threads threads.
+     * Retrograde breadth first search from the goal over states of pattern
+     * tiles (and blank), ranked with the blank cell as the last digit so that
+     * states with the same pattern cells are contiguous. Moving the blank
+     * onto a non pattern tile costs nothing, such states are closed at the
+     * current depth with a depth first search. Each depth, threads take
+     * chunks of the frontier and expand the CURRENT states they claim,
+     * marking pattern tile moves as NEXT, then NEXT states become CURRENT.
+     * Returns the table indexed by rankPlacement of the pattern cells.
+     */
+    template<int WIDTH, int HEIGHT>
+    std::vector<uint8_t> buildPatternDatabase(std::vector<uint8_t> const & tiles,
+                                              int n_threads,
+                                              PatternSpace space =
+                                              PatternSpace::WITH_BLANK) {
+        int const N_TILES = WIDTH*HEIGHT;
+        int const n_pattern = tiles.size();
+        int const blank = n_pattern; // blank cell stored after pattern
+        if (n_pattern + 1 > N_TILES) {
+            throw std::invalid_argument("too many tiles in pattern");
+        }
+        n_threads = std::max(n_threads, 1);
+
+        using Frontier = PatternFrontier;
+        unsigned const NOT_CLOSED = (1u << Frontier::UNSEEN) |
+            (1u << Frontier::CURRENT) | (1u << Frontier::NEXT);
+        uint8_t const UNSEEN_VALUE = 0xFF;
+        size_t const CHUNK_WORDS = 4096;
+
+        bool const with_blank = space == PatternSpace::WITH_BLANK;
+        int const n_cells = n_pattern + with_blank; // cells in state
+        // number of states with the same pattern cells
+        int const n_free = with_blank ? N_TILES - n_pattern : 1;
+        Frontier frontier(nPlacements(N_TILES, n_cells));
+        size_t const n_chunks = (frontier.nWords() + CHUNK_WORDS - 1) / CHUNK_WORDS;
+
+        // written concurrently, all writes of a depth store the same value
+        std::vector< std::atomic<uint8_t> > table(nPlacements(N_TILES, n_pattern));
+        for (auto & value : table) {
+            value.store(UNSEEN_VALUE, std::memory_order_relaxed);
+        }
+
+        std::array<uint8_t, N_TILES> goal_cells;
+        for (int i = 0; i < n_pattern; ++i) {
+            goal_cells[i] = tiles[i];
+        }
+        goal_cells[blank] = 0;
+        frontier.transition(rankPlacement(goal_cells.data(), n_cells, N_TILES),
+                            1u << Frontier::UNSEEN, Frontier::CURRENT);
+
+        for (uint8_t depth = 0; ; ++depth) {
+            if (depth == UNSEEN_VALUE) {
+                throw std::runtime_error("pattern database depth overflow");
+            }
+
+            // expand states of current depth
+            std::atomic<size_t> next_chunk{0};
+            runThreads(n_threads, [&](int) {
+                std::vector<size_t> stack;
+                std::array<uint8_t, N_TILES> cells;
+                auto expand = [&](size_t rank) {
+                    auto & value = table[rank / n_free];
+                    if (value.load(std::memory_order_relaxed) == UNSEEN_VALUE) {
+                        value.store(depth, std::memory_order_relaxed);
+                    }
+
+                    unrankPlacement(rank, n_cells, N_TILES, cells.data());
+
+                    if (!with_blank) {
+                        uint32_t occupied = 0;
+                        for (int i = 0; i < n_pattern; ++i) {
+                            occupied |= 1u << cells[i];
+                        }
+                        for (int i = 0; i < n_pattern; ++i) {
+                            for (auto move : {DOWN, LEFT, RIGHT, UP}) {
+                                auto new_idx =
+                                    getMovedBlankIdx<WIDTH, HEIGHT>(cells[i], move);
+                                if (new_idx < 0 || (occupied >> new_idx) & 1) continue;
+                                auto child_cells = cells;
+                                child_cells[i] = new_idx;
+                                auto child = rankPlacement(child_cells.data(),
+                                                           n_pattern, N_TILES);
+                                frontier.transition(child, 1u << Frontier::UNSEEN,
+                                                    Frontier::NEXT);
+                            }
+                        }
+                        return;
+                    }
+
+                    // rank of child with blank moved to a free cell only
+                    // differs in the last digit, the index of that cell
+                    // among cells free of pattern tiles
+                    auto pattern_rank = rank - rank % n_free;
+                    auto blank_idx = cells[blank];
+
+                    for (auto move : {DOWN, LEFT, RIGHT, UP}) {
+                        auto new_blank_idx =
+                            getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, move);
+                        if (new_blank_idx < 0) continue;
+
+                        auto moved = std::find(cells.begin(),
+                                               cells.begin() + n_pattern,
+                                               new_blank_idx);
+                        if (moved == cells.begin() + n_pattern) {
+                            int digit = new_blank_idx;
+                            for (int j = 0; j < n_pattern; ++j) {
+                                digit -= cells[j] < new_blank_idx;
+                            }
+                            auto child = pattern_rank + digit;
+                            if (frontier.transition(child, NOT_CLOSED,
+                                                    Frontier::CLOSED)) {
+                                stack.push_back(child);
+                            }
+                        } else {
+                            auto child_cells = cells;
+                            child_cells[moved - cells.begin()] = blank_idx;
+                            child_cells[blank] = new_blank_idx;
+                            auto child = rankPlacement(child_cells.data(),
+                                                       n_pattern + 1, N_TILES);
+                            frontier.transition(child, 1u << Frontier::UNSEEN,
+                                                Frontier::NEXT);
+                        }
+                    }
+                };
+
+                for (size_t chunk; (chunk = next_chunk++) < n_chunks;) {
+                    auto end_word = std::min((chunk + 1) * CHUNK_WORDS,
+                                             frontier.nWords());
+                    for (auto word = chunk * CHUNK_WORDS; word < end_word; ++word) {
+                        for (auto mask = frontier.getCurrentMask(word); mask;
+                             mask &= mask - 1) {
+                            auto state = word * Frontier::STATES_PER_WORD +
+                                __builtin_ctzll(mask) / 2;
+                            if (!frontier.transition(state, 1u << Frontier::CURRENT,
+                                                     Frontier::CLOSED)) {
+                                continue; // claimed by free move of other thread
+                            }
+                            stack.push_back(state);
+                            while (!stack.empty()) {
+                                auto rank = stack.back();
+                                stack.pop_back();
+                                expand(rank);
+                            }
+                        }
+                    }
+                }
+            });
+
+            // states of next depth become current
+            std::atomic<size_t> n_next{0};
+            next_chunk = 0;
+            runThreads(n_threads, [&](int) {
+                size_t n_advanced = 0;
+                for (size_t chunk; (chunk = next_chunk++) < n_chunks;) {
+                    auto end_word = std::min((chunk + 1) * CHUNK_WORDS,
+                                             frontier.nWords());
+                    for (auto word = chunk * CHUNK_WORDS; word < end_word; ++word) {
+                        n_advanced += frontier.advance(word);
+                    }
+                }
+                n_next += n_advanced;
+            });
+            if (n_next == 0) break;
+        }
+
+        return std::vector<uint8_t>(table.begin(), table.end());
+    }
+}
+
+#endif
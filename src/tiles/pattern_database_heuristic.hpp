@@ -0,0 +1,416 @@
+#ifndef PATTERN_DATABASE_HEURISTIC_HPP
+#define PATTERN_DATABASE_HEURISTIC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "heuristic.hpp"
+#include "mapped_file.hpp"
+#include "pattern_database_builder.hpp"
+#include "pattern_database_storage.hpp"
+#include "tile_node.hpp"
+
+namespace Tiles {
+
+    // disjoint groups of pattern tiles, e.g. {{1, 2, 3}, {4, 5, 6, 7}}
+    using Partition = std::vector< std::vector<uint8_t> >;
+
+    /* Header of pattern database file, in native byte order.
+     * The table follows at table_offset, aligned to a page so that it can be
+     * memory mapped directly.
+     */
+    struct PatternDatabaseHeader {
+        static constexpr char MAGIC[8] = {'T', 'I', 'L', 'E', 'S', 'P', 'D', 'B'};
+        static uint32_t const VERSION = 1;
+        static uint64_t const PAGE_SIZE = 4096;
+
+        char magic[8];
+        uint32_t version;
+        uint8_t width;
+        uint8_t height;
+        uint8_t n_pattern;
+        PatternCompression compression;
+        uint8_t tiles[32];
+        uint64_t table_offset;
+        uint64_t table_size;
+    };
+    static_assert(sizeof(PatternDatabaseHeader) == 64,
+                  "pattern database header layout changed");
+
+    /* Pattern database of a single group of pattern tiles.
+     * Stores, for every placement of the pattern tiles, the minimum number
+     * of moves of pattern tiles needed to bring them to their goal cells,
+     * minimized over all blank positions (or ignoring the blank, see
+     * PatternSpace). Moves of non pattern tiles are free, so databases of
+     * disjoint groups are additive.
+     * The goal places tile i at index i, as in ManhattanDistanceHeuristic.
+     * Values are stored in the table as given by the Storage policy. The
+     * table is either owned or memory mapped from a file, copies share the
+     * table.
+     */
+    template<int WIDTH, int HEIGHT, typename Storage = ByteStorage>
+    struct PatternDatabase {
+        static int const N_TILES = WIDTH*HEIGHT;
+
+        std::vector<uint8_t> tiles;
+
+        // indexed by rankPlacement of the cells of tiles, encoded by Storage
+        std::shared_ptr<uint8_t const> table;
+        size_t table_size = 0;
+
+        // rank of goal placement
+        size_t goal_rank = 0;
+
+        // build values with parallel breadth first search
+        explicit PatternDatabase(std::vector<uint8_t> pattern_tiles,
+                                 int n_threads = std::thread::hardware_concurrency())
+            : PatternDatabase(pattern_tiles,
+                              buildPatternDatabase<WIDTH, HEIGHT>(pattern_tiles,
+                                                                  n_threads,
+                                                                  Storage::SPACE)) {}
+
+        // encode prebuilt values, one byte per value
+        PatternDatabase(std::vector<uint8_t> pattern_tiles,
+                        std::vector<uint8_t> values)
+            : tiles(std::move(pattern_tiles)) {
+            if (values.size() != nPlacements(N_TILES, tiles.size())) {
+                throw std::invalid_argument("pattern database size mismatch");
+            }
+            auto owned_table = std::make_shared< std::vector<uint8_t> >(
+                Storage::template encode<WIDTH, HEIGHT>(tiles, std::move(values)));
+            table = std::shared_ptr<uint8_t const>(owned_table, owned_table->data());
+            table_size = owned_table->size();
+            checkTableSize();
+        }
+
+        // use table of memory mapped file
+        PatternDatabase(std::vector<uint8_t> pattern_tiles,
+                        MappedFile const & file, size_t table_offset)
+            : tiles(std::move(pattern_tiles)),
+              table(file.data, file.data.get() + table_offset),
+              table_size(file.size - table_offset) {
+            checkTableSize();
+        }
+
+        void checkTableSize() {
+            if (tiles.size() >= N_TILES ||
+                table_size != Storage::getTableSize(nPlacements(N_TILES, tiles.size()))) {
+                throw std::invalid_argument("pattern database size mismatch");
+            }
+            goal_rank = rankPlacement(tiles.data(), tiles.size(), N_TILES);
+        }
+
+        // entry of pattern cells (value, or value mod 3 for Mod3Storage)
+        uint8_t get(uint8_t const * cells) const noexcept {
+            int manhattan = 0;
+            if constexpr (Storage::NEEDS_MANHATTAN) {
+                manhattan = getPatternManhattanDistance<WIDTH>(tiles.data(), cells,
+                                                               tiles.size());
+            }
+            return Storage::get(table.get(),
+                                rankPlacement(cells, tiles.size(), N_TILES),
+                                manhattan);
+        }
+
+        // entry of pattern, given cells of all tiles (indexed by tile)
+        uint8_t lookup(std::array<uint8_t, N_TILES> const & tile_cells)
+            const noexcept {
+            std::array<uint8_t, N_TILES> cells;
+            for (size_t i = 0; i < tiles.size(); ++i) {
+                cells[i] = tile_cells[tiles[i]];
+            }
+            return get(cells.data());
+        }
+
+        // value of pattern for Mod3Storage, by greedy descent to the goal:
+        // some pattern tile move leads to a pattern with value one less,
+        // the one whose residue is one less
+        uint8_t descend(std::array<uint8_t, N_TILES> const & tile_cells)
+            const noexcept {
+            std::array<uint8_t, N_TILES> cells;
+            uint32_t occupied = 0;
+            for (size_t i = 0; i < tiles.size(); ++i) {
+                cells[i] = tile_cells[tiles[i]];
+                occupied |= 1u << cells[i];
+            }
+            uint8_t value = 0;
+            auto residue = get(cells.data());
+            while (rankPlacement(cells.data(), tiles.size(), N_TILES) != goal_rank) {
+                bool descended = false;
+                for (size_t i = 0; i < tiles.size() && !descended; ++i) {
+                    auto cell = cells[i];
+                    for (auto move : {DOWN, LEFT, RIGHT, UP}) {
+                        auto new_cell = getMovedBlankIdx<WIDTH, HEIGHT>(cell, move);
+                        if (new_cell < 0 || (occupied >> new_cell) & 1) continue;
+                        cells[i] = new_cell;
+                        auto new_residue = get(cells.data());
+                        if (new_residue == (residue + 2) % 3) {
+                            occupied ^= (1u << cell) | (1u << new_cell);
+                            residue = new_residue;
+                            descended = true;
+                            break;
+                        }
+                        cells[i] = cell;
+                    }
+                }
+                // only for corrupt tables, value so far is a lower bound
+                if (!descended) break;
+                ++value;
+            }
+            return value;
+        }
+
+        // write header, padding up to the next page, and table
+        void save(std::string const & filename) const {
+            PatternDatabaseHeader header{};
+            std::copy(std::begin(header.MAGIC), std::end(header.MAGIC), header.magic);
+            header.version = PatternDatabaseHeader::VERSION;
+            header.width = WIDTH;
+            header.height = HEIGHT;
+            header.n_pattern = tiles.size();
+            header.compression = Storage::COMPRESSION;
+            std::copy(tiles.begin(), tiles.end(), header.tiles);
+            header.table_offset = PatternDatabaseHeader::PAGE_SIZE;
+            header.table_size = table_size;
+
+            std::ofstream file(filename, std::ios::binary);
+            std::vector<char> padding(header.table_offset - sizeof(header), 0);
+            file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+            file.write(padding.data(), padding.size());
+            file.write(reinterpret_cast<char const *>(table.get()), table_size);
+            if (!file) {
+                throw std::runtime_error("could not write pattern database " +
+                                         filename);
+            }
+        }
+
+        // memory map pattern database written by save, read only
+        static PatternDatabase load(std::string const & filename) {
+            auto file = mapFileReadOnly(filename);
+            PatternDatabaseHeader header;
+            if (file.size < sizeof(header)) {
+                throw std::runtime_error("truncated pattern database " + filename);
+            }
+            std::copy(file.data.get(), file.data.get() + sizeof(header),
+                      reinterpret_cast<uint8_t *>(&header));
+
+            if (!std::equal(std::begin(header.magic), std::end(header.magic),
+                            std::begin(header.MAGIC))) {
+                throw std::runtime_error("not a pattern database " + filename);
+            }
+            if (header.version != PatternDatabaseHeader::VERSION) {
+                throw std::runtime_error("unsupported pattern database version " +
+                                         std::to_string(header.version));
+            }
+            if (header.width != WIDTH || header.height != HEIGHT) {
+                throw std::invalid_argument("pattern database " + filename +
+                                            " is for a different puzzle");
+            }
+            if (header.compression != Storage::COMPRESSION) {
+                throw std::invalid_argument("pattern database " + filename +
+                                            " has a different compression");
+            }
+            if (header.n_pattern >= N_TILES ||
+                header.table_offset + header.table_size != file.size) {
+                throw std::runtime_error("corrupt pattern database " + filename);
+            }
+            return PatternDatabase(std::vector<uint8_t>(header.tiles,
+                                                        header.tiles + header.n_pattern),
+                                   file, header.table_offset);
+        }
+    };
+
+    // 6-6-3 partition of the 15 puzzle
+    inline Partition fifteenPuzzle663Partition() {
+        return {{1, 2, 3, 5, 6, 7}, {8, 9, 10, 12, 13, 14}, {4, 11, 15}};
+    }
+
+    // 7-8 partition of the 15 puzzle
+    inline Partition fifteenPuzzle78Partition() {
+        return {{1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}};
+    }
+
+    // 6-6-6-6 partition of the 24 puzzle (Korf and Felner)
+    inline Partition twentyFourPuzzle6666Partition() {
+        return {{1, 2, 5, 6, 7, 12}, {3, 4, 8, 9, 13, 14},
+                {10, 11, 15, 16, 20, 21}, {17, 18, 19, 22, 23, 24}};
+    }
+
+    // default partition: 6-6-3 for the 15 puzzle, 6-6-6-6 for the 24 puzzle,
+    // otherwise consecutive groups of at most 6 tiles
+    template<int WIDTH, int HEIGHT>
+    Partition getDefaultPartition() {
+        if (WIDTH == 4 && HEIGHT == 4) return fifteenPuzzle663Partition();
+        if (WIDTH == 5 && HEIGHT == 5) return twentyFourPuzzle6666Partition();
+        Partition partition;
+        for (int tile = 1; tile < WIDTH*HEIGHT; ++tile) {
+            if ((tile - 1) % 6 == 0) partition.emplace_back();
+            partition.back().push_back(tile);
+        }
+        return partition;
+    }
+
+    // partition by name ("663", "78", "6666") or explicit comma separated
+    // groups of space separated tiles, e.g. "1 2 3 4, 5 6 7 8"
+    inline Partition getPartitionFromString(std::string const & partition_string) {
+        if (partition_string == "663") return fifteenPuzzle663Partition();
+        if (partition_string == "78") return fifteenPuzzle78Partition();
+        if (partition_string == "6666") return twentyFourPuzzle6666Partition();
+        Partition partition(1);
+        size_t pos = 0;
+        while (pos < partition_string.size()) {
+            auto c = partition_string[pos];
+            if (c == ',') {
+                partition.emplace_back();
+                ++pos;
+            } else if (c == ' ') {
+                ++pos;
+            } else {
+                size_t n_chars = 0;
+                partition.back().push_back(
+                    std::stoi(partition_string.substr(pos), &n_chars));
+                pos += n_chars;
+            }
+        }
+        return partition;
+    }
+
+    /* Additive disjoint pattern database heuristic.
+     * Sum of pattern database values of each group of the partition.
+     * Children only look up the database of the moved tile. With
+     * Mod3Storage entries only give the change from the parent, evalH
+     * finds values by descent and is only used for the root.
+     */
+    template<int WIDTH, int HEIGHT, typename Storage = ByteStorage>
+    struct PatternDatabaseHeuristic {
+        static int const N_TILES = WIDTH*HEIGHT;
+
+        using Database = PatternDatabase<WIDTH, HEIGHT, Storage>;
+
+        std::vector<Database> databases;
+
+        // index of database of each tile, -1 if tile is in no pattern
+        std::array<int8_t, N_TILES> tile_databases;
+
+        PatternDatabaseHeuristic()
+            : PatternDatabaseHeuristic(getDefaultPartition<WIDTH, HEIGHT>()) {}
+
+        explicit PatternDatabaseHeuristic(Partition const & partition) {
+            checkPartition(partition);
+            for (auto const & tiles : partition) {
+                databases.emplace_back(tiles);
+            }
+            setTileDatabases();
+        }
+
+        // use prebuilt databases, e.g. loaded from files
+        explicit PatternDatabaseHeuristic(std::vector<Database> pattern_databases)
+            : databases(std::move(pattern_databases)) {
+            Partition partition;
+            for (auto const & database : databases) {
+                partition.push_back(database.tiles);
+            }
+            checkPartition(partition);
+            setTileDatabases();
+        }
+
+        void setTileDatabases() noexcept {
+            tile_databases.fill(-1);
+            for (size_t i = 0; i < databases.size(); ++i) {
+                for (auto tile : databases[i].tiles) {
+                    tile_databases[tile] = i;
+                }
+            }
+        }
+
+        // load databases from comma separated files
+        static PatternDatabaseHeuristic load(std::string const & filenames) {
+            std::vector<Database> pattern_databases;
+            size_t begin = 0;
+            while (begin <= filenames.size()) {
+                auto end = std::min(filenames.find(',', begin), filenames.size());
+                pattern_databases.push_back(Database::load(
+                    filenames.substr(begin, end - begin)));
+                begin = end + 1;
+            }
+            return PatternDatabaseHeuristic(std::move(pattern_databases));
+        }
+
+        // throws if groups are empty or not disjoint
+        static void checkPartition(Partition const & partition) {
+            std::array<bool, N_TILES> in_pattern{};
+            for (auto const & tiles : partition) {
+                if (tiles.empty()) {
+                    throw std::invalid_argument("empty pattern");
+                }
+                for (auto tile : tiles) {
+                    if (tile == 0 || tile >= N_TILES || in_pattern[tile]) {
+                        throw std::invalid_argument("partition is not disjoint");
+                    }
+                    in_pattern[tile] = true;
+                }
+            }
+        }
+
+        template <typename Node>
+        void evalH(Node & node) const noexcept {
+            std::array<uint8_t, N_TILES> tile_cells;
+            int idx = 0;
+            for (auto tile : node) {
+                tile_cells[tile] = idx++;
+            }
+            int heuristic_value = 0;
+            for (auto const & database : databases) {
+                if constexpr (Storage::IS_MOD3) {
+                    heuristic_value += database.descend(tile_cells);
+                } else {
+                    heuristic_value += database.lookup(tile_cells);
+                }
+            }
+            node.h_val = heuristic_value;
+        }
+
+        // node holds heuristic value of parent, only the database of the
+        // moved tile changes, its entries for the child and the parent are
+        // looked up. The cells of the tiles still come from a scan of the
+        // whole board, so this is O(N) per child like evalH, with two
+        // lookups instead of one per database (two instead of three for
+        // 6-6-3); for Mod3Storage it also avoids the descent of evalH
+        template <typename Node>
+        void evalHIncremental(Node & node) const noexcept {
+            auto parent_blank_idx = getParentBlankIdx(node);
+            auto tile_moved = node.board[parent_blank_idx];
+            if (tile_databases[tile_moved] < 0) return;
+            auto const & database = databases[tile_databases[tile_moved]];
+
+            std::array<uint8_t, N_TILES> tile_cells;
+            int idx = 0;
+            for (auto tile : node) {
+                tile_cells[tile] = idx++;
+            }
+            auto child_entry = database.lookup(tile_cells);
+            tile_cells[tile_moved] = node.blank_idx;
+            auto parent_entry = database.lookup(tile_cells);
+            if constexpr (Storage::IS_MOD3) {
+                node.h_val += Storage::getDelta(child_entry, parent_entry);
+            } else {
+                node.h_val += child_entry - parent_entry;
+            }
+        }
+
+        template <typename Node>
+        void evalChild(Node const & parent, Node & child) const noexcept {
+            child.h_val = parent.h_val;
+            evalHIncremental(child);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef PATTERN_DATABASE_STORAGE_HPP
+#define PATTERN_DATABASE_STORAGE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+#include "pattern_database_builder.hpp"
+#include "tile_node.hpp"
+
+namespace Tiles {
+
+    // compression of pattern database table
+    enum class PatternCompression : uint8_t { NONE = 0, NIBBLE = 1, MOD3 = 2 };
+
+    // sum of manhattan distances of pattern tiles from their goal cells
+    template<int WIDTH>
+    int getPatternManhattanDistance(uint8_t const * tiles, uint8_t const * cells,
+                                    int n_pattern) noexcept {
+        int distance = 0;
+        for (int i = 0; i < n_pattern; ++i) {
+            distance += std::abs(tiles[i] / WIDTH - cells[i] / WIDTH) +
+                std::abs(tiles[i] % WIDTH - cells[i] % WIDTH);
+        }
+        return distance;
+    }
+
+    /* Storage policies of pattern database tables.
+     * encode turns one byte values indexed by rank into a table, get decodes
+     * the entry of a rank given the manhattan distance of the pattern tiles
+     * (only computed by lookups if NEEDS_MANHATTAN).
+     * SPACE is the state space the values are built in.
+     */
+
+    // one byte per value
+    struct ByteStorage {
+        static constexpr PatternCompression COMPRESSION = PatternCompression::NONE;
+        static constexpr PatternSpace SPACE = PatternSpace::WITH_BLANK;
+        static constexpr bool NEEDS_MANHATTAN = false;
+        static constexpr bool IS_MOD3 = false;
+
+        static size_t getTableSize(size_t n_values) noexcept { return n_values; }
+
+        template<int WIDTH, int HEIGHT>
+        static std::vector<uint8_t> encode(std::vector<uint8_t> const &,
+                                           std::vector<uint8_t> values) {
+            return values;
+        }
+
+        static uint8_t get(uint8_t const * table, size_t rank, int) noexcept {
+            return table[rank];
+        }
+    };
+
+    // 4 bits per value, holding half of the excess of the value over the
+    // manhattan distance of the pattern tiles (every pattern tile move
+    // changes both by 1, so the excess is even), saturated at 15 so that
+    // large excesses are underestimated
+    struct NibbleStorage {
+        static constexpr PatternCompression COMPRESSION = PatternCompression::NIBBLE;
+        static constexpr PatternSpace SPACE = PatternSpace::WITH_BLANK;
+        static constexpr bool NEEDS_MANHATTAN = true;
+        static constexpr bool IS_MOD3 = false;
+
+        static size_t getTableSize(size_t n_values) noexcept {
+            return (n_values + 1) / 2;
+        }
+
+        template<int WIDTH, int HEIGHT>
+        static std::vector<uint8_t> encode(std::vector<uint8_t> const & tiles,
+                                           std::vector<uint8_t> const & values) {
+            int const n_pattern = tiles.size();
+            std::vector<uint8_t> table(getTableSize(values.size()), 0);
+            std::vector<uint8_t> cells(n_pattern);
+            for (size_t rank = 0; rank < values.size(); ++rank) {
+                unrankPlacement(rank, n_pattern, WIDTH*HEIGHT, cells.data());
+                auto manhattan = getPatternManhattanDistance<WIDTH>(
+                    tiles.data(), cells.data(), n_pattern);
+                if (values[rank] < manhattan || (values[rank] - manhattan) % 2) {
+                    throw std::invalid_argument("pattern database value below "
+                                                "manhattan distance");
+                }
+                int excess = std::min((values[rank] - manhattan) / 2, 15);
+                table[rank / 2] |= excess << (4 * (rank % 2));
+            }
+            return table;
+        }
+
+        static uint8_t get(uint8_t const * table, size_t rank, int manhattan) noexcept {
+            return manhattan + 2 * ((table[rank / 2] >> (4 * (rank % 2))) & 0xF);
+        }
+    };
+
+    // 2 bits per value, holding the value mod 3. Values of patterns one
+    // move apart differ by at most 1, so the value of a child is recovered
+    // from the value of its parent and the two residues; get returns the
+    // residue. Requires a consistent table, built without the blank.
+    struct Mod3Storage {
+        static constexpr PatternCompression COMPRESSION = PatternCompression::MOD3;
+        static constexpr PatternSpace SPACE = PatternSpace::WITHOUT_BLANK;
+        static constexpr bool NEEDS_MANHATTAN = false;
+        static constexpr bool IS_MOD3 = true;
+
+        static size_t getTableSize(size_t n_values) noexcept {
+            return (n_values + 3) / 4;
+        }
+
+        // difference of child value and parent value from their residues
+        static int getDelta(uint8_t child_residue, uint8_t parent_residue) noexcept {
+            return (child_residue - parent_residue + 4) % 3 - 1;
+        }
+
+        // throws if values of patterns one move apart differ by more than 1
+        template<int WIDTH, int HEIGHT>
+        static std::vector<uint8_t> encode(std::vector<uint8_t> const & tiles,
+                                           std::vector<uint8_t> const & values) {
+            int const n_pattern = tiles.size();
+            std::vector<uint8_t> table(getTableSize(values.size()), 0);
+            std::vector<uint8_t> cells(n_pattern);
+            for (size_t rank = 0; rank < values.size(); ++rank) {
+                unrankPlacement(rank, n_pattern, WIDTH*HEIGHT, cells.data());
+                uint32_t occupied = 0;
+                for (auto cell : cells) {
+                    occupied |= 1u << cell;
+                }
+                for (int i = 0; i < n_pattern; ++i) {
+                    auto cell = cells[i];
+                    for (auto move : {DOWN, LEFT, RIGHT, UP}) {
+                        auto new_cell = getMovedBlankIdx<WIDTH, HEIGHT>(cell, move);
+                        if (new_cell < 0 || (occupied >> new_cell) & 1) continue;
+                        cells[i] = new_cell;
+                        auto child = rankPlacement(cells.data(), n_pattern,
+                                                   WIDTH*HEIGHT);
+                        cells[i] = cell;
+                        if (std::abs(values[child] - values[rank]) > 1) {
+                            throw std::invalid_argument("pattern database is not "
+                                                        "consistent, mod 3 "
+                                                        "encoding needs a table "
+                                                        "built without blank");
+                        }
+                    }
+                }
+                table[rank / 4] |= (values[rank] % 3) << (2 * (rank % 4));
+            }
+            return table;
+        }
+
+        static uint8_t get(uint8_t const * table, size_t rank, int) noexcept {
+            return (table[rank / 4] >> (2 * (rank % 4))) & 3;
+        }
+    };
+}
+
+#endif
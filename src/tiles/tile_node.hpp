@@ -9,6 +9,7 @@
 #include <numeric>
 #include <optional>
 #include <ostream>
+#include "zobrist.hpp"
 
 namespace Tiles {
 
@@ -33,6 +34,42 @@ enum MOVE : uint8_t {
   NONE // best ordering for 15 puzzle
 };
 
+// get index of blank after moving it in direction move,
+// returns -1 if the blank would be moved off the board
+template <int WIDTH, int HEIGHT>
+int getMovedBlankIdx(int blank_idx, MOVE move) noexcept {
+  switch (move) {
+  case UP:
+    if (blank_idx >= WIDTH) {
+      return blank_idx - WIDTH;
+    }
+    break;
+  case DOWN:
+    if (blank_idx < (WIDTH * (HEIGHT - 1))) {
+      return blank_idx + WIDTH;
+    }
+    break;
+  case LEFT:
+    if ((blank_idx % WIDTH) != 0) {
+      return blank_idx - 1;
+    }
+    break;
+  case RIGHT:
+    if ((blank_idx % WIDTH) != (WIDTH - 1)) {
+      return blank_idx + 1;
+    }
+    break;
+  default:
+    break;
+  }
+  return -1;
+}
+
+// move of blank that undoes move
+inline MOVE getInverseMove(MOVE move) noexcept {
+  return static_cast<MOVE>(UP - move);
+}
+
 template <int WIDTH, int HEIGHT> struct TileNode {
 
   // goal board configuration
@@ -75,6 +112,11 @@ template <int WIDTH, int HEIGHT> struct TileNode {
     goal_node.board = goal_board;
   }
 
+  // reseed Zobrist hash table (see ZobristTable::seed)
+  static void seedHash(uint64_t seed) {
+    ZobristTable<WIDTH * HEIGHT>::seed(seed);
+  }
+
   // get index of current blank tile
   uint8_t getBlankIdx() noexcept {
     // not cached, do linear scan
@@ -97,29 +139,9 @@ template <int WIDTH, int HEIGHT> struct TileNode {
   // cache previous move and increments g_val
   std::optional<TileNode<WIDTH, HEIGHT>> moveBlank(MOVE move) const noexcept {
     std::optional<TileNode<WIDTH, HEIGHT>> new_node;
-    switch (move) {
-    case UP:
-      if (blank_idx >= WIDTH) {
-        new_node.emplace(swapBlank(blank_idx - WIDTH));
-      }
-      break;
-    case DOWN:
-      if (blank_idx < (WIDTH * (HEIGHT - 1))) {
-        new_node.emplace(swapBlank(blank_idx + WIDTH));
-      }
-      break;
-    case LEFT:
-      if ((blank_idx % WIDTH) != 0) {
-        new_node.emplace(swapBlank(blank_idx - 1));
-      }
-      break;
-    case RIGHT:
-      if ((blank_idx % WIDTH) != (WIDTH - 1)) {
-        new_node.emplace(swapBlank(blank_idx + 1));
-      }
-      break;
-    default:
-      break;
+    auto new_blank_idx = getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, move);
+    if (new_blank_idx >= 0) {
+      new_node.emplace(swapBlank(new_blank_idx));
     }
     if (new_node.has_value()) {
       new_node->prev_move = move; // cache previous move
@@ -128,6 +150,32 @@ template <int WIDTH, int HEIGHT> struct TileNode {
     return new_node;
   }
 
+  // move blank in direction move in place, cache previous move and
+  // increments g_val, returns false (node unchanged) if the blank would be
+  // moved off the board
+  bool applyMove(MOVE move) noexcept {
+    auto new_blank_idx = getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, move);
+    if (new_blank_idx < 0) {
+      return false;
+    }
+    std::swap(board[blank_idx], board[new_blank_idx]);
+    blank_idx = new_blank_idx;
+    prev_move = move;
+    ++g_val;
+    return true;
+  }
+
+  // undo applyMove(move), restoring previous move and heuristic value
+  void undoMove(MOVE move, MOVE old_prev_move, uint8_t old_h_val) noexcept {
+    auto old_blank_idx =
+        getMovedBlankIdx<WIDTH, HEIGHT>(blank_idx, getInverseMove(move));
+    std::swap(board[blank_idx], board[old_blank_idx]);
+    blank_idx = old_blank_idx;
+    prev_move = old_prev_move;
+    --g_val;
+    h_val = old_h_val;
+  }
+
   // simple iterator
   using const_iterator =
       typename std::array<uint8_t, WIDTH * HEIGHT>::const_iterator;
@@ -158,6 +206,13 @@ bool operator==(TileNode<WIDTH, HEIGHT> const &lhs,
   return lhs.board == rhs.board;
 }
 
+// get Zobrist hash value of board
+template <int WIDTH, int HEIGHT>
+ZobristValue<WIDTH * HEIGHT>
+getHash(TileNode<WIDTH, HEIGHT> const &node) noexcept {
+  return ZobristTable<WIDTH * HEIGHT>::get().hash(node.board);
+}
+
 // get cost of path to node
 template <int WIDTH, int HEIGHT>
 int getG(TileNode<WIDTH, HEIGHT> const &node) noexcept {
@@ -202,6 +257,31 @@ getChildNodes(TileNode<WIDTH, HEIGHT> const &node) noexcept {
   return child_nodes;
 }
 
+// moves of blank, in the order children are generated
+template <int WIDTH, int HEIGHT>
+constexpr std::array<MOVE, N_MOVES>
+getMoves(TileNode<WIDTH, HEIGHT> const &) noexcept {
+  return {DOWN, LEFT, RIGHT, UP};
+}
+
+// move blank of node in place, unless the blank would be moved off the board
+// or the move undoes the previous move (as in getChildNodes), returns whether
+// node was moved
+template <int WIDTH, int HEIGHT>
+bool applyMove(TileNode<WIDTH, HEIGHT> &node, MOVE move) noexcept {
+  if (node.prev_move == getInverseMove(move)) {
+    return false;
+  }
+  return node.applyMove(move);
+}
+
+// undo applyMove(node, move), restoring previous move and heuristic value
+template <int WIDTH, int HEIGHT>
+void undoMove(TileNode<WIDTH, HEIGHT> &node, MOVE move, MOVE prev_move,
+              uint8_t h_val) noexcept {
+  node.undoMove(move, prev_move, h_val);
+}
+
 template <int WIDTH, int HEIGHT>
 std::optional<TileNode<WIDTH, HEIGHT>>
 getParent(TileNode<WIDTH, HEIGHT> const &node) noexcept {
@@ -0,0 +1,311 @@
+#ifndef WALKING_DISTANCE_HEURISTIC_HPP
+#define WALKING_DISTANCE_HEURISTIC_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "heuristic.hpp"
+#include "tile_node.hpp"
+
+namespace Tiles {
+
+    /* Walking distance table of one direction (rows or columns).
+     * A state counts, for each line, the tiles in the line with each goal
+     * line, plus the line of the blank. The blank swaps with a tile of an
+     * adjacent line in one move. Distances are found by breadth first
+     * search from the goal when the table is constructed.
+     * Key packs counts of the first N_LINES - 1 goal lines of each line in
+     * 3 bits each (the last count follows from the line length), and the
+     * line of the blank in the top bits.
+     * States are ranked densely (65 million states and one byte each for
+     * the 24 puzzle): for each blank line, lines are ranked in order, each
+     * by the number of states with a smaller count vector in that line and
+     * the same counts in the lines before it, which depends only on the
+     * tiles remaining for the lines after it.
+     */
+    template<int N_LINES, int LINE_LENGTH>
+    struct WalkingDistanceTable {
+        static_assert(N_LINES <= 5 && LINE_LENGTH <= 7,
+                      "walking distance key does not fit in 64 bits");
+
+        static int const BITS = 3;
+        static int const BLANK_SHIFT = BITS * N_LINES * (N_LINES - 1);
+        // bits of the key of one line, and of a vector of counts of all
+        // goal lines
+        static int const LINE_BITS = BITS * (N_LINES - 1);
+        static int const VECTOR_BITS = BITS * N_LINES;
+        static constexpr uint8_t UNSEEN = 0xFF;
+
+        using Counts = std::array< std::array<uint8_t, N_LINES>, N_LINES>;
+
+        // distances indexed by rank of state
+        std::vector<uint8_t> distances;
+
+        // index of count vector among vectors with the same sum, -1 if a
+        // count is larger than LINE_LENGTH
+        std::vector<int16_t> vector_idxs;
+
+        // number of vectors with each sum
+        std::array<uint32_t, N_LINES * LINE_LENGTH + 1> n_vectors;
+
+        // sum of counts of key of a line
+        std::vector<uint8_t> line_sums;
+
+        // tiles left for lines after line, given the blank line, for each
+        // remaining vector and vector of the line, the number of states with
+        // a smaller vector in the line, indexed by
+        // [blank_line][line][remaining_idx * n vectors of line + vector_idx]
+        std::array< std::array< std::vector<uint32_t>, N_LINES>, N_LINES> preceding;
+
+        // first rank of states with each blank line
+        std::array<uint32_t, N_LINES + 1> blank_offsets;
+
+        // part of key of tile with goal line goal_line in line
+        static uint64_t getTilePart(int line, int goal_line) noexcept {
+            if (goal_line == N_LINES - 1) return 0;
+            return uint64_t(1) << (BITS * (line * (N_LINES - 1) + goal_line));
+        }
+
+        // part of key of blank in line
+        static uint64_t getBlankPart(int line) noexcept {
+            return uint64_t(line) << BLANK_SHIFT;
+        }
+
+        static uint64_t getKey(Counts const & counts, int blank_line) noexcept {
+            uint64_t key = getBlankPart(blank_line);
+            for (int line = 0; line < N_LINES; ++line) {
+                for (int goal_line = 0; goal_line < N_LINES - 1; ++goal_line) {
+                    key += counts[line][goal_line] * getTilePart(line, goal_line);
+                }
+            }
+            return key;
+        }
+
+        static Counts getCounts(uint64_t key, int & blank_line) noexcept {
+            Counts counts;
+            blank_line = key >> BLANK_SHIFT;
+            for (int line = 0; line < N_LINES; ++line) {
+                int n_tiles = getLineLength(line, blank_line);
+                for (int goal_line = 0; goal_line < N_LINES - 1; ++goal_line) {
+                    counts[line][goal_line] = (key >> (BITS * (line * (N_LINES - 1) +
+                                                               goal_line))) & 7;
+                    n_tiles -= counts[line][goal_line];
+                }
+                counts[line][N_LINES - 1] = n_tiles;
+            }
+            return counts;
+        }
+
+        // number of tiles in line
+        static int getLineLength(int line, int blank_line) noexcept {
+            return LINE_LENGTH - (line == blank_line);
+        }
+
+        // vector of tiles of each goal line in all lines
+        static uint32_t getGoalVector() noexcept {
+            uint32_t vector = 0;
+            for (int goal_line = 0; goal_line < N_LINES; ++goal_line) {
+                vector |= uint32_t(getLineLength(goal_line, 0)) << (BITS * goal_line);
+            }
+            return vector;
+        }
+
+        WalkingDistanceTable() {
+            // index vectors by sum
+            std::array<std::vector<uint32_t>, N_LINES * LINE_LENGTH + 1> vectors;
+            vector_idxs.assign(1u << VECTOR_BITS, -1);
+            for (uint32_t vector = 0; vector < (1u << VECTOR_BITS); ++vector) {
+                int sum = 0;
+                bool valid = true;
+                for (int goal_line = 0; goal_line < N_LINES; ++goal_line) {
+                    int count = (vector >> (BITS * goal_line)) & 7;
+                    valid &= count <= LINE_LENGTH;
+                    sum += count;
+                }
+                if (!valid) continue;
+                vector_idxs[vector] = vectors[sum].size();
+                vectors[sum].push_back(vector);
+            }
+            for (size_t sum = 0; sum < vectors.size(); ++sum) {
+                n_vectors[sum] = vectors[sum].size();
+            }
+            line_sums.resize(1u << LINE_BITS);
+            for (uint32_t line_key = 0; line_key < (1u << LINE_BITS); ++line_key) {
+                for (int goal_line = 0; goal_line < N_LINES - 1; ++goal_line) {
+                    line_sums[line_key] += (line_key >> (BITS * goal_line)) & 7;
+                }
+            }
+
+            // v fits in remaining, no count goes below 0
+            auto fits = [](uint32_t v, uint32_t remaining) {
+                for (int goal_line = 0; goal_line < N_LINES; ++goal_line) {
+                    if (((v >> (BITS * goal_line)) & 7) >
+                        ((remaining >> (BITS * goal_line)) & 7)) return false;
+                }
+                return true;
+            };
+
+            blank_offsets[0] = 0;
+            for (int blank_line = 0; blank_line < N_LINES; ++blank_line) {
+                // number of states of the lines after line, indexed by
+                // vector of tiles remaining for them
+                int remaining_sum = 0;
+                std::vector<uint32_t> n_states = {1}; // no lines, no tiles
+                for (int line = N_LINES - 1; line >= 0; --line) {
+                    int line_sum = getLineLength(line, blank_line);
+                    auto const & line_vectors = vectors[line_sum];
+                    remaining_sum += line_sum;
+                    auto const & remaining_vectors = vectors[remaining_sum];
+
+                    auto & line_preceding = preceding[blank_line][line];
+                    line_preceding.assign(remaining_vectors.size() *
+                                          line_vectors.size(), 0);
+                    std::vector<uint32_t> line_n_states(remaining_vectors.size(), 0);
+                    for (size_t i = 0; i < remaining_vectors.size(); ++i) {
+                        uint32_t n = 0;
+                        for (size_t j = 0; j < line_vectors.size(); ++j) {
+                            line_preceding[i * line_vectors.size() + j] = n;
+                            if (!fits(line_vectors[j], remaining_vectors[i])) continue;
+                            auto next = remaining_vectors[i] - line_vectors[j];
+                            n += n_states[vector_idxs[next]];
+                        }
+                        line_n_states[i] = n;
+                    }
+                    n_states.swap(line_n_states);
+                }
+                blank_offsets[blank_line + 1] = blank_offsets[blank_line] +
+                    n_states[vector_idxs[getGoalVector()]];
+            }
+
+            // breadth first search from goal: tiles in their goal lines,
+            // blank in line 0
+            distances.assign(blank_offsets[N_LINES], UNSEEN);
+            Counts goal_counts{};
+            for (int line = 0; line < N_LINES; ++line) {
+                goal_counts[line][line] = getLineLength(line, 0);
+            }
+            std::vector<uint64_t> current = {getKey(goal_counts, 0)};
+            std::vector<uint64_t> next;
+            distances[getRank(current.front())] = 0;
+
+            for (uint8_t distance = 1; !current.empty(); ++distance) {
+                for (auto key : current) {
+                    int blank_line;
+                    auto counts = getCounts(key, blank_line);
+                    for (int new_blank_line : {blank_line - 1, blank_line + 1}) {
+                        if (new_blank_line < 0 || new_blank_line >= N_LINES) continue;
+                        for (int goal_line = 0; goal_line < N_LINES; ++goal_line) {
+                            if (counts[new_blank_line][goal_line] == 0) continue;
+                            // tile of new blank line moves into blank line
+                            auto child = key - getBlankPart(blank_line) +
+                                getBlankPart(new_blank_line) -
+                                getTilePart(new_blank_line, goal_line) +
+                                getTilePart(blank_line, goal_line);
+                            auto & child_distance = distances[getRank(child)];
+                            if (child_distance == UNSEEN) {
+                                child_distance = distance;
+                                next.push_back(child);
+                            }
+                        }
+                    }
+                }
+                current.swap(next);
+                next.clear();
+            }
+        }
+
+        uint32_t getRank(uint64_t key) const noexcept {
+            int blank_line = key >> BLANK_SHIFT;
+            uint32_t rank = blank_offsets[blank_line];
+            uint32_t remaining = getGoalVector();
+            // last line follows from the tiles remaining
+            for (int line = 0; line < N_LINES - 1; ++line) {
+                uint32_t line_key = (key >> (LINE_BITS * line)) & ((1u << LINE_BITS) - 1);
+                int line_sum = getLineLength(line, blank_line);
+                uint32_t vector = line_key |
+                    (uint32_t(line_sum - line_sums[line_key]) << LINE_BITS);
+                rank += preceding[blank_line][line][vector_idxs[remaining] *
+                                                    n_vectors[line_sum] +
+                                                    vector_idxs[vector]];
+                remaining -= vector;
+            }
+            return rank;
+        }
+
+        uint8_t lookup(uint64_t key) const noexcept {
+            return distances[getRank(key)];
+        }
+    };
+
+    // table shared by all heuristics of the process, built on first use
+    template<int N_LINES, int LINE_LENGTH>
+    WalkingDistanceTable<N_LINES, LINE_LENGTH> const & getWalkingDistanceTable() {
+        static WalkingDistanceTable<N_LINES, LINE_LENGTH> const table;
+        return table;
+    }
+
+    /* Walking distance heuristic: sum of vertical walking distance (tiles
+     * counted by row) and horizontal walking distance (tiles counted by
+     * column). Each move moves a tile vertically or horizontally, so the sum
+     * is admissible, and it dominates manhattan distance.
+     * The goal places tile i at index i, as in ManhattanDistanceHeuristic.
+     */
+    template<int WIDTH, int HEIGHT>
+    struct WalkingDistanceHeuristic {
+        static int const N_TILES = WIDTH*HEIGHT;
+
+        WalkingDistanceTable<HEIGHT, WIDTH> const & row_table;
+        WalkingDistanceTable<WIDTH, HEIGHT> const & col_table;
+
+        // part of key of row (column) table of each tile at each index
+        std::array< std::array<uint64_t, N_TILES>, N_TILES> row_parts;
+        std::array< std::array<uint64_t, N_TILES>, N_TILES> col_parts;
+
+        WalkingDistanceHeuristic()
+            : row_table(getWalkingDistanceTable<HEIGHT, WIDTH>()),
+              col_table(getWalkingDistanceTable<WIDTH, HEIGHT>()) {
+            for (int tile = 0; tile < N_TILES; ++tile) {
+                for (int idx = 0; idx < N_TILES; ++idx) {
+                    if (tile == 0) {
+                        row_parts[tile][idx] = row_table.getBlankPart(idx / WIDTH);
+                        col_parts[tile][idx] = col_table.getBlankPart(idx % WIDTH);
+                    } else {
+                        row_parts[tile][idx] =
+                            row_table.getTilePart(idx / WIDTH, tile / WIDTH);
+                        col_parts[tile][idx] =
+                            col_table.getTilePart(idx % WIDTH, tile % WIDTH);
+                    }
+                }
+            }
+        }
+
+        template <typename Node>
+        void evalH(Node & node) const noexcept {
+            uint64_t row_key = 0;
+            uint64_t col_key = 0;
+            int idx = 0;
+            for (auto tile : node) {
+                row_key += row_parts[tile][idx];
+                col_key += col_parts[tile][idx];
+                ++idx;
+            }
+            node.h_val = row_table.lookup(row_key) + col_table.lookup(col_key);
+        }
+
+        // no incremental update: the table keys depend on every tile and
+        // are not stored in nodes, so rebuilding the key of the changed
+        // direction costs as much as evaluating node in full
+        template <typename Node>
+        void evalHIncremental(Node & node) const noexcept {
+            evalH(node);
+        }
+
+        // full evaluation, see evalHIncremental
+        template <typename Node>
+        void evalChild(Node const &, Node & child) const noexcept {
+            evalH(child);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef BACKOFF_HPP
+#define BACKOFF_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/* Exponential backoff for idle threads: the first N_YIELDS pauses yield the
+ * processor, later pauses sleep (park the thread), starting at MIN_SLEEP and
+ * doubling up to MAX_SLEEP, so idle threads don't take cycles from threads
+ * with work. reset() once work is found.
+ */
+class Backoff {
+    static constexpr int N_YIELDS = 16;
+    static constexpr std::chrono::microseconds MIN_SLEEP{1};
+    static constexpr std::chrono::microseconds MAX_SLEEP{1000};
+
+    int n_pauses = 0;
+    std::chrono::microseconds sleep = MIN_SLEEP;
+
+public:
+    void pause() {
+        if (n_pauses < N_YIELDS) {
+            ++n_pauses;
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(sleep);
+        sleep = std::min(2 * sleep, MAX_SLEEP);
+    }
+
+    void reset() noexcept {
+        n_pauses = 0;
+        sleep = MIN_SLEEP;
+    }
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef BARRIER_HPP
+#define BARRIER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include "backoff.hpp"
+
+/* Reusable barrier of n_threads threads: wait returns once all n_threads
+ * threads have called it, and writes made before wait by any thread are
+ * visible to all threads after it. The last thread to arrive starts the next
+ * generation, waiting threads back off (see Backoff), so threads parked at
+ * the barrier between phases don't take cycles from working threads.
+ */
+class Barrier {
+    int const n_threads;
+    std::atomic<int> n_arrived = 0;
+    std::atomic<size_t> generation = 0;
+
+public:
+    explicit Barrier(int n_threads) : n_threads(n_threads) {}
+
+    void wait() {
+        auto current = generation.load(std::memory_order_acquire);
+        if (n_arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == n_threads) {
+            n_arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        Backoff backoff;
+        while (generation.load(std::memory_order_acquire) == current) {
+            backoff.pause();
+        }
+    }
+};
+
+#endif
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <cstring>
 #include <cctype>
 #include <exception>
+#include <limits>
 #include <iostream>
 #include <map>
 #include <memory>
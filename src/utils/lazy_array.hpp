@@ -0,0 +1,71 @@
+#ifndef LAZY_ARRAY_HPP
+#define LAZY_ARRAY_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <sys/mman.h>
+
+// array of zero initialized elements in an anonymous memory mapping, pages
+// are only backed by memory when first written, so construction takes
+// constant time and memory use grows with the elements used. Elements must
+// be valid when all their bytes are zero (e.g. null pointers, integers,
+// unlocked spin locks) and are never destroyed
+template <typename T> class LazyArray {
+  static_assert(std::is_trivially_destructible<T>::value,
+                "lazy array elements are not destroyed");
+
+public:
+  LazyArray() = default;
+
+  explicit LazyArray(size_t n_elements) : n_elements(n_elements) {
+    if (n_elements == 0) {
+      return;
+    }
+    void *address =
+        mmap(nullptr, getBytes(), PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (address == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    elements = static_cast<T *>(address);
+  }
+
+  LazyArray(LazyArray const &) = delete;
+  LazyArray &operator=(LazyArray const &) = delete;
+
+  LazyArray(LazyArray &&other) noexcept
+      : elements(std::exchange(other.elements, nullptr)),
+        n_elements(std::exchange(other.n_elements, 0)) {}
+
+  LazyArray &operator=(LazyArray &&other) noexcept {
+    std::swap(elements, other.elements);
+    std::swap(n_elements, other.n_elements);
+    return *this;
+  }
+
+  ~LazyArray() {
+    if (elements != nullptr) {
+      munmap(elements, getBytes());
+    }
+  }
+
+  T &operator[](size_t idx) noexcept { return elements[idx]; }
+  T const &operator[](size_t idx) const noexcept { return elements[idx]; }
+
+  size_t size() const noexcept { return n_elements; }
+
+  T *begin() noexcept { return elements; }
+  T *end() noexcept { return elements + n_elements; }
+  T const *begin() const noexcept { return elements; }
+  T const *end() const noexcept { return elements + n_elements; }
+
+private:
+  size_t getBytes() const noexcept { return n_elements * sizeof(T); }
+
+  T *elements = nullptr;
+  size_t n_elements = 0;
+};
+
+#endif
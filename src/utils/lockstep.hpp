@@ -0,0 +1,66 @@
+#ifndef LOCKSTEP_HPP
+#define LOCKSTEP_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/* Runs the steps of n_threads threads one at a time, in thread id order,
+ * round robin, so a concurrent search makes the same decisions on every run.
+ * A thread calls wait before each step and pass after it, and leave instead
+ * of pass when it is done, removing it from the rotation. Only the thread
+ * whose step it is writes the state, waiting threads spin (yielding) on the
+ * turn. All calls are no-ops if disabled.
+ */
+class Lockstep {
+    bool const enabled;
+    int const n_threads;
+    std::atomic<int> turn = 0; // thread id of the thread whose step it is
+    std::vector<bool> done;
+
+    // give turn to the next thread that is not done
+    void next(int thread_id) {
+        auto next_id = thread_id;
+        for (int i = 0; i < n_threads; ++i) {
+            next_id = (next_id + 1) % n_threads;
+            if (!done[next_id]) break;
+        }
+        turn.store(next_id, std::memory_order_release);
+    }
+
+public:
+    Lockstep(int n_threads, bool enabled)
+        : enabled(enabled), n_threads(n_threads), done(n_threads) {}
+
+    // block until it is the step of thread_id
+    void wait(int thread_id) const {
+        if (!enabled) return;
+        while (turn.load(std::memory_order_acquire) != thread_id) {
+            std::this_thread::yield();
+        }
+    }
+
+    // end the step of thread_id
+    void pass(int thread_id) {
+        if (!enabled) return;
+        next(thread_id);
+    }
+
+    // end the step of thread_id, and skip it from now on
+    void leave(int thread_id) {
+        if (!enabled) return;
+        done[thread_id] = true;
+        next(thread_id);
+    }
+
+    bool isEnabled() const noexcept { return enabled; }
+
+    // restart the rotation from thread 0 with all threads, before the
+    // threads take their first step
+    void reset() {
+        done.assign(n_threads, false);
+        turn = 0;
+    }
+};
+
+#endif
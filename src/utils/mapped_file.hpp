@@ -0,0 +1,46 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// read only memory mapping of a whole file, unmapped when the last copy of
+// data is destroyed; processes mapping the same file share its page cache
+struct MappedFile {
+  std::shared_ptr<uint8_t const> data;
+  size_t size = 0;
+};
+
+inline MappedFile mapFileReadOnly(std::string const &filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("could not open " + filename);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("could not map empty file " + filename);
+  }
+  size_t size = file_stat.st_size;
+  void *address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // mapping stays valid
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("could not map " + filename);
+  }
+  MappedFile mapped_file;
+  mapped_file.data = std::shared_ptr<uint8_t const>(
+      static_cast<uint8_t const *>(address),
+      [size](uint8_t const *data) {
+        munmap(const_cast<uint8_t *>(data), size);
+      });
+  mapped_file.size = size;
+  return mapped_file;
+}
+
+#endif
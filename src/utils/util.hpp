@@ -1,8 +1,12 @@
 #ifndef UTIL_HPP
 #define UTIL_HPP
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 template<int N_TILES>
 std::array<uint8_t, N_TILES>
@@ -17,4 +21,29 @@ getBoardFromString(std::string const &board_string) {
   return board;
 }
 
+// number of distinct values of HashFunction, 2^BITS if it declares BITS
+// (fewer than 64), otherwise unlimited
+template <typename HashFunction, typename = void> struct HashRange {
+  static constexpr size_t value = std::numeric_limits<size_t>::max();
+};
+
+template <typename HashFunction>
+struct HashRange<HashFunction, std::void_t<decltype(HashFunction::BITS)>> {
+  static constexpr size_t value = HashFunction::BITS < 64
+                                      ? size_t(1) << HashFunction::BITS
+                                      : std::numeric_limits<size_t>::max();
+};
+
+// number of closed list entries, as many as fit in memory_budget_mb
+// megabytes if given, otherwise closed_capacity, at most the number of
+// distinct hash values of the closed list, entries beyond are never indexed
+template <typename Closed>
+size_t getClosedEntries(size_t closed_capacity, size_t memory_budget_mb) {
+  using HashFunction = std::remove_const_t<decltype(Closed::hasher)>;
+  auto entries = memory_budget_mb == 0
+                     ? closed_capacity
+                     : memory_budget_mb * 1024 * 1024 / Closed::BYTES_PER_ENTRY;
+  return std::min(entries, HashRange<HashFunction>::value);
+}
+
 #endif
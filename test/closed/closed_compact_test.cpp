@@ -0,0 +1,104 @@
+#include "closed_compact.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+struct DummyNode {
+    int id;
+    int g_value = 0;
+
+    DummyNode(int id, int g_value) :
+        id(id),
+        g_value(g_value) {}
+
+    bool operator==(DummyNode const & rhs) const {
+        return id == rhs.id;
+    }
+};
+
+int getG(DummyNode const & node) {
+    return node.g_value;
+}
+
+uint64_t getKey(DummyNode const & node) {
+    return static_cast<uint64_t>(node.id) + 1; // never zero
+}
+
+// overload default hash
+namespace std
+{
+    template<>
+    struct hash<DummyNode>
+    {
+        size_t
+        operator()(const DummyNode&) const
+        {
+            return 0; // force collision
+        }
+    };
+}
+
+class ClosedInitialize : public testing::Test {
+public:
+    DummyNode node0 = DummyNode{0, 3}; // g-value 3
+    DummyNode node1 = DummyNode{1, 3}; // g-value 3
+    DummyNode node2 = DummyNode{2, 3}; // g-value 3
+    ClosedCompact<DummyNode, std::hash<DummyNode>, 100> closed;
+
+    virtual void SetUp() {
+        closed.insert(node2);
+        closed.insert(node0);
+        closed.insert(node1);
+    }
+};
+
+TEST_F(ClosedInitialize, correctSizeOnInserts) {
+    ASSERT_EQ(closed.size, 3);
+}
+
+TEST_F(ClosedInitialize, insertUniqueNode) {
+    auto node = DummyNode{3, 3};
+    // insert return true when node needs to be expanded
+    ASSERT_TRUE(closed.insert(node));
+}
+
+TEST_F(ClosedInitialize, insertNonUniqueNode) {
+    auto node = DummyNode{0, 3};
+    ASSERT_FALSE(closed.insert(node));
+    ASSERT_FALSE(closed.insert(DummyNode{1, 4}));
+}
+
+// inserting non unique node with lower g-value triggers reopening
+TEST_F(ClosedInitialize, Reopening) {
+    auto node = DummyNode{0, 2};
+    ASSERT_TRUE(closed.insert(node));
+    ASSERT_FALSE(closed.insert(node));
+    ASSERT_EQ(closed.size, 3);
+}
+
+// only the given node is returned, its g value is the path cost
+TEST_F(ClosedInitialize, PathIsNode) {
+    ASSERT_THAT(closed.getPath(node1), testing::ElementsAre(node1));
+}
+
+TEST(ClosedCompact, SmallerThanNodeEntries) {
+    using Closed = ClosedCompact<DummyNode, std::hash<DummyNode>, 100>;
+    ASSERT_EQ(Closed::BYTES_PER_ENTRY, sizeof(uint64_t) + sizeof(uint8_t));
+}
+
+// inserting into a full closed list throws
+TEST(ClosedCompact, FullClosedListThrows) {
+    ClosedCompact<DummyNode, std::hash<DummyNode>, 4> closed;
+    for (int id = 0; id < 4; ++id) {
+        EXPECT_TRUE(closed.insert(DummyNode{id, 3}));
+    }
+    EXPECT_FALSE(closed.insert(DummyNode{2, 3}));
+    EXPECT_THROW(closed.insert(DummyNode{4, 3}), std::length_error);
+    EXPECT_EQ(closed.size, 4);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+#include "closed_open_address_pool.hpp"
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+struct DummyNode {
+    int id;
+    int f_value = 0;
+    std::shared_ptr<DummyNode> parent_node = nullptr;
+
+    DummyNode() : id(-1), f_value(-1) {}
+
+    DummyNode(int id, int f_value) :
+        id(id),
+        f_value(f_value) {}
+
+    bool operator==(DummyNode const & rhs) const {
+        return id == rhs.id;
+    }
+    bool operator !=(DummyNode const & rhs) const {
+        return id != rhs.id;
+    }
+};
+
+int getF(DummyNode const & node) {
+    return node.f_value;
+}
+
+std::optional<DummyNode> getParent(DummyNode const & node) {
+    if (node.parent_node) {
+        return *node.parent_node;
+    }
+    return {};
+}
+
+// overload default hash
+namespace std
+{
+    template<>
+    struct hash<DummyNode>
+    {
+        size_t
+        operator()(const DummyNode&) const
+        {
+            return 0; // force collision
+        }
+    };
+}
+
+class ClosedInitialize : public testing::Test {
+public:
+    DummyNode node0 = DummyNode{0, 3}; // f-value 3
+    DummyNode node1 = DummyNode{1, 3}; // f-value 3
+    DummyNode node2 = DummyNode{2, 3}; // f-value 3
+    ClosedOpenAddressPool<DummyNode, std::hash<DummyNode>, 100> closed;
+
+    virtual void SetUp() {
+        closed.insert(node2);
+        closed.insert(node0);
+        closed.insert(node1);
+    }
+};
+
+
+TEST_F(ClosedInitialize, correctSizeOnInserts) {
+    ASSERT_EQ(closed.size, 3);
+}
+
+TEST_F(ClosedInitialize, insertUniqueNode) {
+    auto node = DummyNode{3, 3};
+    // insert return true when node needs to be expanded
+    ASSERT_TRUE(closed.insert(node));
+}
+
+TEST_F(ClosedInitialize, insertNonUniqueNode) {
+    auto node = DummyNode{0, 3};
+    ASSERT_FALSE(closed.insert(node));
+}
+
+// inserting non unique node with lower f-value triggers reopening
+TEST_F(ClosedInitialize, Reopening) {
+    auto node = DummyNode{0, 2};
+    ASSERT_TRUE(closed.insert(node));
+}
+
+TEST_F(ClosedInitialize, RebuildPath) {
+    DummyNode node3 = DummyNode{3, 0};
+    DummyNode node4 = DummyNode{4, 0};
+    node4.parent_node = std::make_shared<DummyNode>(node3);
+    DummyNode node5 = DummyNode{5, 0};
+    node5.parent_node = std::make_shared<DummyNode>(node4);
+    EXPECT_TRUE(closed.insert(node3));
+    EXPECT_TRUE(closed.insert(node4));
+    EXPECT_TRUE(closed.insert(node5));
+    ASSERT_THAT(closed.getPath(node5),
+                testing::ElementsAre(node3, node4, node5));
+}
+
+// entries link to the entry of their parent, also when the parent is not
+// the last inserted entry
+TEST_F(ClosedInitialize, EntriesLinkToParent) {
+    DummyNode node3 = DummyNode{3, 0};
+    DummyNode node4 = DummyNode{4, 0};
+    node4.parent_node = std::make_shared<DummyNode>(node3);
+    DummyNode node5 = DummyNode{5, 0};
+    node5.parent_node = std::make_shared<DummyNode>(node3);
+    EXPECT_TRUE(closed.insert(node3));
+    EXPECT_TRUE(closed.insert(node4));
+    EXPECT_TRUE(closed.insert(node5));
+    EXPECT_EQ(closed.find(node4)->parent, closed.find(node3));
+    EXPECT_EQ(closed.find(node5)->parent, closed.find(node3));
+    EXPECT_EQ(closed.find(node3)->parent, nullptr);
+    ASSERT_THAT(closed.getPath(node5), testing::ElementsAre(node3, node5));
+}
+
+TEST_F(ClosedInitialize, PathOfMissingNodeIsEmpty) {
+    ASSERT_TRUE(closed.getPath(DummyNode{42, 0}).empty());
+}
+
+// inserting into a full closed list throws, finding a missing node stops
+TEST(ClosedOpenAddressPool, FullClosedListThrows) {
+    ClosedOpenAddressPool<DummyNode, std::hash<DummyNode>, 4> closed;
+    for (int id = 0; id < 4; ++id) {
+        EXPECT_TRUE(closed.insert(DummyNode{id, 3}));
+    }
+    EXPECT_FALSE(closed.insert(DummyNode{2, 3}));
+    EXPECT_THROW(closed.insert(DummyNode{4, 3}), std::length_error);
+    EXPECT_EQ(closed.find(DummyNode{4, 3}), nullptr);
+    EXPECT_EQ(closed.size, 4);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
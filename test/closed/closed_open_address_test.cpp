@@ -1,6 +1,7 @@
 #include "closed_open_address.hpp"
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -97,6 +98,28 @@ TEST_F(ClosedInitialize, RebuildPath) {
                 testing::ElementsAre(node3, node4, node5));
 }
 
+TEST_F(ClosedInitialize, FindStoredNode) {
+    auto closed_node = closed.find(DummyNode{1, 0});
+    ASSERT_NE(closed_node, nullptr);
+    EXPECT_EQ(closed_node->f_value, 3);
+    EXPECT_EQ(closed.find(DummyNode{42, 0}), nullptr);
+}
+
+TEST_F(ClosedInitialize, PathOfMissingNodeIsEmpty) {
+    ASSERT_TRUE(closed.getPath(DummyNode{42, 0}).empty());
+}
+
+// inserting into a full closed list throws, finding a missing node stops
+TEST(ClosedOpenAddress, FullClosedListThrows) {
+    ClosedOpenAddress<DummyNode, std::hash<DummyNode>, 4> closed;
+    for (int id = 0; id < 4; ++id) {
+        EXPECT_TRUE(closed.insert(DummyNode{id, 3}));
+    }
+    EXPECT_FALSE(closed.insert(DummyNode{2, 3}));
+    EXPECT_THROW(closed.insert(DummyNode{4, 3}), std::length_error);
+    EXPECT_EQ(closed.find(DummyNode{4, 3}), nullptr);
+    EXPECT_EQ(closed.size, 4);
+}
 
 int main(int argc, char *argv[]) {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,155 @@
+#include "closed_resizable.hpp"
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+struct DummyNode {
+    int id;
+    int f_value = 0;
+    std::shared_ptr<DummyNode> parent_node = nullptr;
+
+    DummyNode(int id, int f_value) :
+        id(id),
+        f_value(f_value) {}
+
+    bool operator==(DummyNode const & rhs) const {
+        return id == rhs.id;
+    }
+};
+
+int getF(DummyNode const & node) {
+    return node.f_value;
+}
+
+std::optional<DummyNode> getParent(DummyNode const & node) {
+    if (node.parent_node) {
+        return *node.parent_node;
+    }
+    return {};
+}
+
+// overload default hash
+namespace std
+{
+    template<>
+    struct hash<DummyNode>
+    {
+        size_t
+        operator()(const DummyNode& node) const
+        {
+            return hash<int>()(node.id);
+        }
+    };
+}
+
+using Closed = ClosedResizable<DummyNode, std::hash<DummyNode>>;
+
+class ClosedInitialize : public testing::Test {
+public:
+    DummyNode node0 = DummyNode{0, 3}; // f-value 3
+    DummyNode node1 = DummyNode{1, 3}; // f-value 3
+    DummyNode node2 = DummyNode{2, 3}; // f-value 3
+    Closed closed{4}; // resized on third insert
+
+    virtual void SetUp() {
+        closed.insert(node2);
+        closed.insert(node0);
+        closed.insert(node1);
+    }
+};
+
+TEST_F(ClosedInitialize, correctSizeOnInserts) {
+    ASSERT_EQ(closed.size, 3);
+    ASSERT_EQ(closed.n_resizes, 1);
+}
+
+TEST_F(ClosedInitialize, insertUniqueNode) {
+    auto node = DummyNode{3, 3};
+    // insert return true when node needs to be expanded
+    ASSERT_TRUE(closed.insert(node));
+}
+
+TEST_F(ClosedInitialize, insertNonUniqueNode) {
+    auto node = DummyNode{0, 3};
+    ASSERT_FALSE(closed.insert(node));
+}
+
+// inserting non unique node with lower f-value triggers reopening
+TEST_F(ClosedInitialize, Reopening) {
+    auto node = DummyNode{0, 2};
+    ASSERT_TRUE(closed.insert(node));
+    ASSERT_FALSE(closed.insert(node));
+    ASSERT_EQ(closed.size, 3);
+}
+
+TEST_F(ClosedInitialize, RebuildPath) {
+    DummyNode node3 = DummyNode{3, 0};
+    DummyNode node4 = DummyNode{4, 0};
+    node4.parent_node = std::make_shared<DummyNode>(node3);
+    DummyNode node5 = DummyNode{5, 0};
+    node5.parent_node = std::make_shared<DummyNode>(node4);
+    EXPECT_TRUE(closed.insert(node3));
+    EXPECT_TRUE(closed.insert(node4));
+    EXPECT_TRUE(closed.insert(node5));
+    ASSERT_THAT(closed.getPath(node5),
+                testing::ElementsAre(node3, node4, node5));
+}
+
+TEST_F(ClosedInitialize, PathOfMissingNodeIsEmpty) {
+    ASSERT_TRUE(closed.getPath(DummyNode{42, 0}).empty());
+}
+
+// many inserts from a small table, nodes are found before, during and
+// after migrating
+TEST(ClosedResizable, GrowsFromSmallTable) {
+    Closed closed{2};
+    int const n_nodes = 10000;
+    for (int id = 0; id < n_nodes; ++id) {
+        ASSERT_TRUE(closed.insert(DummyNode{id, 10}));
+        ASSERT_FALSE(closed.insert(DummyNode{id / 2, 10}));
+    }
+    EXPECT_EQ(closed.size, n_nodes);
+    EXPECT_LE(closed.size, Closed::MAX_LOAD_FACTOR * closed.closed.size());
+    EXPECT_GT(closed.n_resizes, 10);
+
+    for (int id = 0; id < n_nodes; ++id) {
+        ASSERT_FALSE(closed.insert(DummyNode{id, 10}));
+    }
+    EXPECT_EQ(closed.size, n_nodes);
+}
+
+// node reopened before its bucket is migrated keeps the lower f-value
+TEST(ClosedResizable, ReopeningWhileMigrating) {
+    Closed closed{64};
+    for (int id = 0; id <= 32; ++id) { // resized on last insert
+        closed.insert(DummyNode{id, 10});
+    }
+    ASSERT_EQ(closed.n_resizes, 1);
+    ASSERT_FALSE(closed.migrating.empty());
+
+    auto reopened = DummyNode{30, 5};
+    EXPECT_TRUE(closed.insert(reopened));
+    for (int id = 100; id < 120; ++id) { // finish migrating
+        closed.insert(DummyNode{id, 10});
+    }
+    EXPECT_TRUE(closed.migrating.empty());
+    EXPECT_EQ(closed.n_resizes, 1);
+    EXPECT_EQ(getF(closed.getPath(reopened).back()), 5);
+    EXPECT_FALSE(closed.insert(DummyNode{30, 7}));
+}
+
+TEST(ClosedResizable, ReportsResizes) {
+    Closed closed{2};
+    closed.insert(DummyNode{0, 0});
+    closed.insert(DummyNode{1, 0});
+    std::stringstream ss;
+    ss << closed;
+    EXPECT_THAT(ss.str(), testing::HasSubstr("closed list resizes: 1"));
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+#include "closed_swiss.hpp"
+#include <optional>
+#include <stdexcept>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// trivially destructible, parent referred to by id
+struct DummyNode {
+    int id = -1;
+    int f_value = 0;
+    int parent_id = -1;
+
+    DummyNode() = default;
+
+    DummyNode(int id, int f_value, int parent_id = -1) :
+        id(id),
+        f_value(f_value),
+        parent_id(parent_id) {}
+
+    bool operator==(DummyNode const & rhs) const {
+        return id == rhs.id;
+    }
+};
+
+int getF(DummyNode const & node) {
+    return node.f_value;
+}
+
+std::optional<DummyNode> getParent(DummyNode const & node) {
+    if (node.parent_id >= 0) {
+        return DummyNode{node.parent_id, 0};
+    }
+    return {};
+}
+
+// overload default hash
+namespace std
+{
+    template<>
+    struct hash<DummyNode>
+    {
+        size_t
+        operator()(const DummyNode& node) const
+        {
+            return node.id % 4; // force collisions, tags of ids 0 and 4 match
+        }
+    };
+}
+
+using Closed = ClosedSwiss<DummyNode, std::hash<DummyNode>, 100>;
+
+class ClosedInitialize : public testing::Test {
+public:
+    DummyNode node0 = DummyNode{0, 3}; // f-value 3
+    DummyNode node1 = DummyNode{1, 3}; // f-value 3
+    DummyNode node4 = DummyNode{4, 3}; // f-value 3, same tag as node0
+    Closed closed;
+
+    virtual void SetUp() {
+        closed.insert(node4);
+        closed.insert(node0);
+        closed.insert(node1);
+    }
+};
+
+TEST_F(ClosedInitialize, correctSizeOnInserts) {
+    ASSERT_EQ(closed.size, 3);
+}
+
+TEST_F(ClosedInitialize, insertUniqueNode) {
+    auto node = DummyNode{8, 3};
+    // insert return true when node needs to be expanded
+    ASSERT_TRUE(closed.insert(node));
+}
+
+TEST_F(ClosedInitialize, insertNonUniqueNode) {
+    ASSERT_FALSE(closed.insert(DummyNode{0, 3}));
+    ASSERT_FALSE(closed.insert(DummyNode{4, 3}));
+}
+
+// inserting non unique node with lower f-value triggers reopening
+TEST_F(ClosedInitialize, Reopening) {
+    auto node = DummyNode{0, 2};
+    ASSERT_TRUE(closed.insert(node));
+    ASSERT_FALSE(closed.insert(node));
+    ASSERT_EQ(closed.size, 3);
+}
+
+TEST_F(ClosedInitialize, RebuildPath) {
+    DummyNode node3 = DummyNode{3, 0};
+    DummyNode node5 = DummyNode{5, 0, 3};
+    DummyNode node6 = DummyNode{6, 0, 5};
+    EXPECT_TRUE(closed.insert(node3));
+    EXPECT_TRUE(closed.insert(node5));
+    EXPECT_TRUE(closed.insert(node6));
+    ASSERT_THAT(closed.getPath(node6),
+                testing::ElementsAre(node3, node5, node6));
+}
+
+TEST_F(ClosedInitialize, PathOfMissingNodeIsEmpty) {
+    ASSERT_TRUE(closed.getPath(DummyNode{42, 0}).empty());
+}
+
+// probes continue into following groups, wrapping around, until full
+TEST(ClosedSwiss, FillsAllGroups) {
+    Closed closed{40}; // rounded up to 3 groups
+    ASSERT_EQ(closed.closed.size(), 48);
+    for (int id = 0; id < 48; ++id) {
+        ASSERT_TRUE(closed.insert(DummyNode{id, 0}));
+    }
+    for (int id = 0; id < 48; ++id) {
+        ASSERT_FALSE(closed.insert(DummyNode{id, 0}));
+    }
+    EXPECT_THROW(closed.insert(DummyNode{48, 0}), std::length_error);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include "concurrent_closed_lock_free.hpp"
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+struct DummyNode {
+    int id;
+    int f_value = 0;
+    std::shared_ptr<DummyNode> parent_node = nullptr;
+
+    DummyNode(int id, int f_value) :
+        id(id),
+        f_value(f_value) {}
+
+    bool operator==(DummyNode const & rhs) const {
+        return id == rhs.id;
+    }
+};
+
+int getF(DummyNode const & node) {
+    return node.f_value;
+}
+
+std::optional<DummyNode> getParent(DummyNode const & node) {
+    if (node.parent_node) {
+        return *node.parent_node;
+    }
+    return {};
+}
+
+// overload default hash
+namespace std
+{
+    template<>
+    struct hash<DummyNode>
+    {
+        size_t
+        operator()(const DummyNode& node) const
+        {
+            return node.id % 8; // force collisions
+        }
+    };
+}
+
+using Closed = ConcurrentClosedLockFree<DummyNode, std::hash<DummyNode>, 1024>;
+
+class ClosedInitialize : public testing::Test {
+public:
+    DummyNode node0 = DummyNode{0, 3}; // f-value 3
+    DummyNode node1 = DummyNode{1, 3}; // f-value 3
+    DummyNode node8 = DummyNode{8, 3}; // f-value 3, collides with node0
+    boost::object_pool<DummyNode> pool;
+    Closed closed;
+
+    virtual void SetUp() {
+        closed.insert(node8, pool);
+        closed.insert(node0, pool);
+        closed.insert(node1, pool);
+    }
+};
+
+TEST_F(ClosedInitialize, correctSizeOnInserts) {
+    ASSERT_EQ(closed.size(), 3);
+}
+
+TEST_F(ClosedInitialize, insertUniqueNode) {
+    auto node = DummyNode{16, 3};
+    // insert return true when node needs to be expanded
+    ASSERT_TRUE(closed.insert(node, pool));
+}
+
+TEST_F(ClosedInitialize, insertNonUniqueNode) {
+    auto node = DummyNode{0, 3};
+    ASSERT_FALSE(closed.insert(node, pool));
+}
+
+// inserting non unique node with lower f-value triggers reopening
+TEST_F(ClosedInitialize, Reopening) {
+    auto node = DummyNode{0, 2};
+    ASSERT_TRUE(closed.insert(node, pool));
+    ASSERT_FALSE(closed.insert(node, pool));
+    ASSERT_EQ(closed.size(), 3);
+}
+
+TEST_F(ClosedInitialize, RebuildPath) {
+    DummyNode node3 = DummyNode{3, 0};
+    DummyNode node4 = DummyNode{4, 0};
+    node4.parent_node = std::make_shared<DummyNode>(node3);
+    DummyNode node5 = DummyNode{5, 0};
+    node5.parent_node = std::make_shared<DummyNode>(node4);
+    EXPECT_TRUE(closed.insert(node3, pool));
+    EXPECT_TRUE(closed.insert(node4, pool));
+    EXPECT_TRUE(closed.insert(node5, pool));
+    ASSERT_THAT(closed.getPath(node5),
+                testing::ElementsAre(node3, node4, node5));
+}
+
+// threads insert the same nodes with decreasing f-values, each node is
+// inserted once and ends up with the lowest f-value
+TEST(ConcurrentClosedLockFree, ConcurrentInserts) {
+    int const n_threads = 4;
+    int const n_nodes = 500;
+    Closed closed(1024, n_threads);
+    std::vector<boost::object_pool<DummyNode>> pools(n_threads);
+    std::vector<std::thread> threads;
+    for (int thread_id = 0; thread_id < n_threads; ++thread_id) {
+        threads.emplace_back([&, thread_id] {
+            for (int f_value = 10; f_value > 0; --f_value) {
+                for (int id = 0; id < n_nodes; ++id) {
+                    closed.insert(DummyNode{id, f_value + thread_id % 2},
+                                  pools[thread_id], thread_id);
+                }
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(closed.size(), n_nodes);
+    for (int id = 0; id < n_nodes; ++id) {
+        auto path = closed.getPath(DummyNode{id, 0});
+        ASSERT_EQ(path.size(), 1);
+        EXPECT_EQ(getF(path.front()), 1);
+    }
+}
+
+// inserting into a full closed list throws, finding a missing node stops
+TEST(ConcurrentClosedLockFree, FullClosedListThrows) {
+    ConcurrentClosedLockFree<DummyNode, std::hash<DummyNode>, 4> closed;
+    boost::object_pool<DummyNode> pool;
+    for (int id = 0; id < 4; ++id) {
+        EXPECT_TRUE(closed.insert(DummyNode{id, 3}, pool));
+    }
+    EXPECT_FALSE(closed.insert(DummyNode{2, 3}, pool));
+    EXPECT_THROW(closed.insert(DummyNode{4, 3}, pool), std::length_error);
+    EXPECT_EQ(closed.find(DummyNode{4, 3}), nullptr);
+    EXPECT_EQ(closed.size(), 4);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
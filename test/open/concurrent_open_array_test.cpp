@@ -0,0 +1,79 @@
+#include "concurrent_open_array.hpp"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <optional>
+#include <vector>
+
+struct DummyNode {
+    int heuristic_value = 0;
+    int cost = 0;
+
+    DummyNode(int heuristic_value, int cost) :
+        heuristic_value(heuristic_value),
+        cost(cost) {}
+
+    bool operator==(DummyNode const & rhs) const {
+        return heuristic_value == rhs.heuristic_value &&
+            cost == rhs.cost;
+    }
+};
+
+int getH(DummyNode const & node) {
+    return node.heuristic_value;
+}
+
+int getG(DummyNode const & node) {
+    return node.cost;
+}
+
+int getF(DummyNode const & node) {
+    return getG(node) + getH(node);
+}
+
+// distributes nodes to threads by cost
+struct DummyHash {
+    size_t operator()(DummyNode const & node) const {
+        return node.cost;
+    }
+};
+
+using Open = ConcurrentOpenArray<DummyNode, 10, DummyHash>;
+
+TEST(ConcurrentOpenArrayTest, PushToOwner) {
+    Open open(2);
+    DummyNode node{1, 3};
+    EXPECT_EQ(open.owner(node), 1);
+    open.push(node);
+    EXPECT_FALSE(open.pop(0).has_value());
+    EXPECT_EQ(open.pop(1), node);
+    EXPECT_FALSE(open.pop(1).has_value());
+}
+
+TEST(ConcurrentOpenArrayTest, PushBatchPopsLowestFHighestG) {
+    Open open(2);
+    std::vector<DummyNode> nodes{{3, 0}, {0, 2}, {1, 1}, {2, 2}};
+    open.push(0, nodes);
+    EXPECT_TRUE(nodes.empty());
+    EXPECT_FALSE(open.pop(1).has_value());
+    EXPECT_EQ(open.pop(0), DummyNode(0, 2));
+    EXPECT_EQ(open.pop(0), DummyNode(1, 1));
+    EXPECT_EQ(open.pop(0), DummyNode(3, 0));
+    EXPECT_EQ(open.pop(0), DummyNode(2, 2));
+    EXPECT_FALSE(open.pop(0).has_value());
+}
+
+TEST(ConcurrentOpenArrayTest, PushBatchSkipsDisabledBucket) {
+    Open open(2);
+    EXPECT_TRUE(open.kill_open(0, 0));
+    std::vector<DummyNode> nodes{{1, 0}, {1, 1}};
+    open.push(0, nodes);
+    EXPECT_EQ(open.queue[0].size, 0);
+    EXPECT_EQ(open.queue[1].size, 2);
+    EXPECT_EQ(open.pop(1), DummyNode(1, 0));
+    EXPECT_EQ(open.pop(1), DummyNode(1, 1));
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,36 @@
+#ifndef RANDOM_WALK_HPP
+#define RANDOM_WALK_HPP
+
+#include <random>
+#include "tile_node.hpp"
+
+// random walk from goal, moving the blank until the g value of the node is
+// n_moves, moves back to the parent are not generated
+template <typename Node>
+Node randomWalk(std::mt19937 & rng, int n_moves) {
+    auto node = Node::goal_node;
+    std::uniform_int_distribution<int> dist(0, Tiles::N_MOVES - 1);
+    while (getG(node) < n_moves) {
+        auto child_node = node.moveBlank(static_cast<Tiles::MOVE>(dist(rng)));
+        if (child_node.has_value()) node = *child_node;
+    }
+    return node;
+}
+
+// initial node of a search: random walk of n_moves moves from goal applied
+// in place (moves may undo each other, so the solution is usually shorter),
+// with g value and previous move reset
+template <typename Node>
+Node randomInitialNode(int n_moves, std::mt19937::result_type seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, Tiles::N_MOVES - 1);
+    auto node = Node::goal_node;
+    while (getG(node) < n_moves) {
+        applyMove(node, static_cast<Tiles::MOVE>(dist(rng)));
+    }
+    node.g_val = 0;
+    node.prev_move = Tiles::NONE;
+    return node;
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include "concurrent_astar.hpp"
+#include "in_place_idastar.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "zobrist.hpp"
+#include "random_walk.hpp"
+#include <array>
+#include <stdexcept>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+int const WIDTH = 4;
+int const HEIGHT = 4;
+
+using Node = PackedTileNode<WIDTH, HEIGHT>;
+using Heuristic = ManhattanDistanceHeuristic<WIDTH, HEIGHT>;
+using HashFunction = ZobristHash<Node>;
+size_t const ClosedEntries = 1 << 20;
+
+using ConcurrentAStarSearch = ConcurrentAStar<Node, Heuristic, HashFunction, ClosedEntries>;
+
+class ConcurrentAStarInitialize: public testing::Test {
+public:
+    Node initial_node = randomInitialNode<Node>(40, 1);
+};
+
+TEST_F(ConcurrentAStarInitialize, SameLengthAsIDAStar) {
+    auto serial_path = InPlaceIDAStar<Node, Heuristic>().search(initial_node);
+    for (int n_threads : {1, 2, 4}) {
+        ConcurrentAStarSearch concurrent(Heuristic(), n_threads);
+        auto path = concurrent.search(initial_node);
+        ASSERT_EQ(path.size(), serial_path.size());
+        EXPECT_EQ(path.front(), initial_node);
+        EXPECT_TRUE(isGoal(path.back()));
+    }
+}
+
+TEST_F(ConcurrentAStarInitialize, DeterministicCounts) {
+    ConcurrentAStarSearch first(Heuristic(), 3, ClosedEntries, true);
+    ConcurrentAStarSearch second(Heuristic(), 3, ClosedEntries, true);
+    auto path = first.search(initial_node);
+    EXPECT_EQ(second.search(initial_node), path);
+    EXPECT_EQ(second.expanded(), first.expanded());
+    EXPECT_EQ(second.generated(), first.generated());
+    ASSERT_EQ(first.thread_counts.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(second.counts(i).expanded, first.counts(i).expanded);
+        EXPECT_GT(first.counts(i).expanded, 0);
+    }
+}
+
+TEST_F(ConcurrentAStarInitialize, BatchedSameLengthAsIDAStar) {
+    auto serial_path = InPlaceIDAStar<Node, Heuristic>().search(initial_node);
+    for (size_t batch_size : {4, 64}) {
+        for (int n_threads : {1, 2, 4}) {
+            ConcurrentAStarSearch concurrent(Heuristic(), n_threads,
+                                             ClosedEntries, false, batch_size);
+            auto path = concurrent.search(initial_node);
+            ASSERT_EQ(path.size(), serial_path.size());
+            EXPECT_EQ(path.front(), initial_node);
+            EXPECT_TRUE(isGoal(path.back()));
+        }
+    }
+}
+
+TEST_F(ConcurrentAStarInitialize, BatchedDeterministicCounts) {
+    ConcurrentAStarSearch first(Heuristic(), 3, ClosedEntries, true, 16);
+    ConcurrentAStarSearch second(Heuristic(), 3, ClosedEntries, true, 16);
+    auto path = first.search(initial_node);
+    EXPECT_EQ(second.search(initial_node), path);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(second.counts(i).expanded, first.counts(i).expanded);
+        EXPECT_EQ(second.counts(i).generated, first.counts(i).generated);
+    }
+}
+
+// a thread inserting into the full closed list stops all threads, search
+// rethrows its exception
+TEST_F(ConcurrentAStarInitialize, FullClosedListThrows) {
+    for (int n_threads : {1, 4}) {
+        ConcurrentAStarSearch concurrent(Heuristic(), n_threads, 100);
+        EXPECT_THROW(concurrent.search(initial_node), std::length_error);
+    }
+}
+
+TEST(ConcurrentAStarUnsolvable, ExhaustsSearchSpace) {
+    // tiles 1 and 2 swapped, 360 of the 720 boards are reachable, none is
+    // the goal
+    using SmallNode = PackedTileNode<3, 2>;
+    using SmallHeuristic = ManhattanDistanceHeuristic<3, 2>;
+    auto initial_node = SmallNode(std::array<uint8_t, 6>{{0, 2, 1, 3, 4, 5}});
+    for (int n_threads : {1, 2, 4}) {
+        ConcurrentAStar<SmallNode, SmallHeuristic, ZobristHash<SmallNode>, 1 << 10>
+            search(SmallHeuristic(), n_threads);
+        EXPECT_TRUE(search.search(initial_node).empty());
+        // concurrent searches may reopen nodes
+        EXPECT_GE(search.expanded(), 360);
+    }
+}
+
+TEST(ConcurrentAStarUnsolvable, BatchedExhaustsSearchSpace) {
+    using SmallNode = PackedTileNode<3, 2>;
+    using SmallHeuristic = ManhattanDistanceHeuristic<3, 2>;
+    auto initial_node = SmallNode(std::array<uint8_t, 6>{{0, 2, 1, 3, 4, 5}});
+    for (int n_threads : {1, 2, 4}) {
+        // children held in outboxes are pushed once a thread runs out of work
+        ConcurrentAStar<SmallNode, SmallHeuristic, ZobristHash<SmallNode>, 1 << 10>
+            search(SmallHeuristic(), n_threads, 1 << 10, false, 1000);
+        EXPECT_TRUE(search.search(initial_node).empty());
+        EXPECT_GE(search.expanded(), 360);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
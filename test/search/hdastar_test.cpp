@@ -0,0 +1,82 @@
+#include "hdastar.hpp"
+#include "in_place_idastar.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "zobrist.hpp"
+#include "random_walk.hpp"
+#include <array>
+#include <stdexcept>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+int const WIDTH = 4;
+int const HEIGHT = 4;
+
+using Node = PackedTileNode<WIDTH, HEIGHT>;
+using Heuristic = ManhattanDistanceHeuristic<WIDTH, HEIGHT>;
+using HashFunction = ZobristHash<Node>;
+size_t const ClosedEntries = 1 << 20;
+
+using HDAStarSearch = HDAStar<Node, Heuristic, HashFunction, ClosedEntries>;
+
+class HDAStarInitialize: public testing::Test {
+public:
+    Node initial_node = randomInitialNode<Node>(40, 1);
+
+    // path is a sequence of moves from initial node to goal
+    void checkPath(std::vector<Node> const & path, size_t expected_size) {
+        ASSERT_EQ(path.size(), expected_size);
+        EXPECT_EQ(path.front(), initial_node);
+        EXPECT_TRUE(isGoal(path.back()));
+        for (size_t i = 1; i < path.size(); ++i) {
+            EXPECT_EQ(getG(path[i]), i);
+            EXPECT_EQ(getParent(path[i]), path[i - 1]);
+        }
+    }
+};
+
+TEST_F(HDAStarInitialize, SameLengthAsIDAStar) {
+    auto serial_path = InPlaceIDAStar<Node, Heuristic>().search(initial_node);
+    for (int n_threads : {1, 2, 4}) {
+        HDAStarSearch hdastar(Heuristic(), n_threads);
+        checkPath(hdastar.search(initial_node), serial_path.size());
+        EXPECT_GT(hdastar.expanded(), 0);
+    }
+}
+
+TEST_F(HDAStarInitialize, InitialNodeIsGoal) {
+    initial_node = Node::goal_node;
+    HDAStarSearch hdastar(Heuristic(), 2);
+    checkPath(hdastar.search(initial_node), 1);
+}
+
+// a thread inserting into its full closed partition stops all threads,
+// search rethrows its exception
+TEST_F(HDAStarInitialize, FullClosedListThrows) {
+    for (int n_threads : {1, 4}) {
+        HDAStarSearch hdastar(Heuristic(), n_threads, 100);
+        EXPECT_THROW(hdastar.search(initial_node), std::length_error);
+    }
+}
+
+TEST(HDAStarUnsolvable, ExhaustsSearchSpace) {
+    // tiles 1 and 2 swapped, 360 of the 720 boards are reachable, none is
+    // the goal
+    using SmallNode = PackedTileNode<3, 2>;
+    using SmallHeuristic = ManhattanDistanceHeuristic<3, 2>;
+    auto initial_node = SmallNode(std::array<uint8_t, 6>{{0, 2, 1, 3, 4, 5}});
+    for (int n_threads : {1, 2, 4}) {
+        HDAStar<SmallNode, SmallHeuristic, ZobristHash<SmallNode>, 1 << 10>
+            search(SmallHeuristic(), n_threads);
+        EXPECT_TRUE(search.search(initial_node).empty());
+        // concurrent searches may reopen nodes
+        EXPECT_GE(search.expanded(), 360);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+#include "idastar.hpp"
+#include "in_place_idastar.hpp"
+#include "linear_conflict_heuristic.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "tile_node.hpp"
+#include "random_walk.hpp"
+#include <array>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+int const WIDTH = 4;
+int const HEIGHT = 4;
+int const N_TILES = WIDTH*HEIGHT;
+
+using Node = PackedTileNode<WIDTH, HEIGHT>;
+using Heuristic = LinearConflictHeuristic<WIDTH, HEIGHT>;
+
+class InPlaceIDAStarInitialize: public testing::Test {
+public:
+    Node initial_node = randomInitialNode<Node>(40, 0);
+};
+
+TEST_F(InPlaceIDAStarInitialize, InPlaceIDAStarReturnsCorrectPath) {
+    auto path = InPlaceIDAStar<TileNode<5, 5>, ManhattanDistanceHeuristic<5, 5>>()
+        .search(TileNode<5, 5>(std::array<uint8_t, 25>(
+                    {{1, 2, 3, 4, 0, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                      15, 16, 17, 18, 19, 20, 21, 22, 23, 24}})));
+    EXPECT_EQ(getG(*(path.end() - 1)), 4);
+    EXPECT_EQ(getH(*(path.begin())), 4);
+    EXPECT_EQ(getH(*(path.end() - 1)), 0);
+    EXPECT_TRUE(isGoal(*(path.end() - 1)));
+    ASSERT_EQ(path.size(), 5);
+}
+
+TEST_F(InPlaceIDAStarInitialize, SameSearchAsIDAStar) {
+    auto in_place = InPlaceIDAStar<Node, Heuristic>();
+    auto copying = IDAStar<Node, Heuristic>();
+    auto in_place_path = in_place.search(initial_node);
+    auto copying_path = copying.search(initial_node);
+
+    // same nodes in same order
+    EXPECT_EQ(in_place.expanded, copying.expanded);
+    EXPECT_EQ(in_place.generated, copying.generated);
+    ASSERT_EQ(in_place_path.size(), copying_path.size());
+    for (size_t i = 0; i < in_place_path.size(); ++i) {
+        EXPECT_EQ(in_place_path[i], copying_path[i]);
+        EXPECT_EQ(getG(in_place_path[i]), i);
+        EXPECT_EQ(getH(in_place_path[i]), getH(copying_path[i]));
+    }
+    // node is left at the goal
+    EXPECT_TRUE(isGoal(in_place.node));
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+#include "in_place_idastar.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "parallel_idastar.hpp"
+#include "tile_node.hpp"
+#include "random_walk.hpp"
+#include <array>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+int const WIDTH = 4;
+int const HEIGHT = 4;
+
+using Node = PackedTileNode<WIDTH, HEIGHT>;
+using Heuristic = ManhattanDistanceHeuristic<WIDTH, HEIGHT>;
+
+class ParallelIDAStarInitialize: public testing::Test {
+public:
+    Node initial_node = randomInitialNode<Node>(40, 1);
+
+    // path is a sequence of moves from initial node to goal
+    void checkPath(std::vector<Node> const & path, size_t expected_size) {
+        ASSERT_EQ(path.size(), expected_size);
+        EXPECT_EQ(path.front(), initial_node);
+        EXPECT_TRUE(isGoal(path.back()));
+        for (size_t i = 1; i < path.size(); ++i) {
+            EXPECT_EQ(getG(path[i]), i);
+            EXPECT_EQ(getParent(path[i]), path[i - 1]);
+        }
+        EXPECT_EQ(getH(path.back()), 0);
+    }
+};
+
+TEST_F(ParallelIDAStarInitialize, SameLengthAsIDAStar) {
+    auto serial_path = InPlaceIDAStar<Node, Heuristic>().search(initial_node);
+    for (int n_threads : {1, 2, 4}) {
+        for (int frontier_depth : {0, 1, 6, 12}) {
+            ParallelIDAStar<Node, Heuristic> parallel(Heuristic(), n_threads,
+                                                      frontier_depth);
+            checkPath(parallel.search(initial_node), serial_path.size());
+        }
+    }
+}
+
+TEST_F(ParallelIDAStarInitialize, DeterministicCounts) {
+    ParallelIDAStar<Node, Heuristic> first(Heuristic(), 3, 6, true);
+    ParallelIDAStar<Node, Heuristic> second(Heuristic(), 3, 6, true);
+    auto path = first.search(initial_node);
+    EXPECT_EQ(second.search(initial_node), path);
+    EXPECT_EQ(second.expanded(), first.expanded());
+    EXPECT_EQ(second.generated(), first.generated());
+}
+
+TEST_F(ParallelIDAStarInitialize, GoalBeforeFrontierDepth) {
+    // solution shorter than frontier depth is found while collecting
+    auto node = Node::goal_node;
+    applyMove(node, DOWN);
+    applyMove(node, RIGHT);
+    node.g_val = 0;
+    node.prev_move = NONE;
+    initial_node = node;
+    ParallelIDAStar<Node, Heuristic> parallel(Heuristic(), 2, 10);
+    checkPath(parallel.search(initial_node), 3);
+}
+
+TEST_F(ParallelIDAStarInitialize, InitialNodeIsGoal) {
+    initial_node = Node::goal_node;
+    ParallelIDAStar<Node, Heuristic> parallel(Heuristic(), 2, 10);
+    checkPath(parallel.search(initial_node), 1);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,100 @@
+#include "linear_conflict_heuristic.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "pattern_database_heuristic.hpp"
+#include "tile_node.hpp"
+#include "random_walk.hpp"
+#include <random>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+TEST(LinearConflict, LineConflicts) {
+    // key digits are goal positions, least significant cell first, 4 is none
+    EXPECT_EQ(getLineConflicts(0 + 1*5 + 2*25 + 3*125, 4), 0);
+    EXPECT_EQ(getLineConflicts(1 + 0*5 + 4*25 + 4*125, 4), 2);
+    // 3 2 1 0: 3 tiles leave the line, not 6 pairwise conflicts
+    EXPECT_EQ(getLineConflicts(3 + 2*5 + 1*25 + 0*125, 4), 6);
+    EXPECT_EQ(getLineConflicts(2 + 1*5 + 0*25 + 4*125, 4), 4);
+}
+
+TEST(LinearConflict, ConflictsAddedToManhattan) {
+    LinearConflictHeuristic<3, 3> heuristic;
+    auto node = TileNode<3, 3>::goal_node;
+    evalH(node, heuristic);
+    EXPECT_EQ(getH(node), 0);
+
+    // initial board
+    /* 0  2  1
+       3  4  5
+       6  7  8 */
+    // tiles 1 and 2 conflict in row, manhattan distance is 2
+    node = TileNode<3, 3>({0, 2, 1, 3, 4, 5, 6, 7, 8});
+    evalH(node, heuristic);
+    EXPECT_EQ(getH(node), 4);
+
+    // initial board
+    /* 6  1  2
+       3  4  5
+       0  7  8 */
+    // tiles 3 and 6 conflict in column, the blank is in no line
+    node = TileNode<3, 3>({6, 1, 2, 3, 4, 5, 0, 7, 8});
+    evalH(node, heuristic);
+    EXPECT_EQ(getH(node), 4);
+
+    // initial board
+    /* 3  1  2
+       0  4  5
+       6  7  8 */
+    node = TileNode<3, 3>({3, 1, 2, 0, 4, 5, 6, 7, 8});
+    evalH(node, heuristic);
+    EXPECT_EQ(getH(node), 1);
+}
+
+TEST(LinearConflict, AdmissibleAndDominatesManhattan) {
+    LinearConflictHeuristic<3, 3> heuristic;
+    ManhattanDistanceHeuristic<3, 3> manhattan;
+    PatternDatabaseHeuristic<3, 3> exact({{1, 2, 3, 4, 5, 6, 7, 8}});
+    std::mt19937 rng(0);
+    for (int i = 0; i < 1000; ++i) {
+        auto node = randomWalk<TileNode<3, 3>>(rng, 40);
+        evalH(node, heuristic);
+        auto linear_conflict_h = getH(node);
+        evalH(node, manhattan);
+        auto manhattan_h = getH(node);
+        evalH(node, exact);
+        auto exact_h = getH(node);
+
+        EXPECT_LE(manhattan_h, linear_conflict_h);
+        EXPECT_LE(linear_conflict_h, exact_h);
+        EXPECT_EQ(linear_conflict_h % 2, exact_h % 2);
+    }
+}
+
+template <typename Node, typename Heuristic>
+void checkIncremental(Heuristic const & heuristic) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> dist(0, N_MOVES - 1);
+    auto node = randomWalk<Node>(rng, 50);
+    heuristic.evalH(node);
+    for (int i = 0; i < 2000; ++i) {
+        auto child_node = node.moveBlank(static_cast<MOVE>(dist(rng)));
+        if (!child_node.has_value()) continue;
+        auto expected = *child_node;
+        heuristic.evalH(expected);
+        heuristic.evalChild(node, *child_node);
+        ASSERT_EQ(getH(*child_node), getH(expected));
+        node = *child_node;
+    }
+}
+
+TEST(LinearConflict, IncrementalMatchesFull) {
+    checkIncremental<TileNode<3, 4>>(LinearConflictHeuristic<3, 4>());
+    checkIncremental<PackedTileNode<4, 4>>(LinearConflictHeuristic<4, 4>());
+    checkIncremental<PackedTileNode<5, 5>>(LinearConflictHeuristic<5, 5>());
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
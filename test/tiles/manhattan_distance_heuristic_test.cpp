@@ -65,6 +65,17 @@ TEST_F(BoardInitialize, correctIncrementalManhattanHeuristic2) {
     ASSERT_EQ(child_node->h_val, child_node_copy->h_val);
 }
 
+TEST_F(BoardInitialize, correctChildManhattanHeuristic) {
+    evalH(node, heuristic);
+    for (auto child_node : getChildNodes(node)) {
+        if (!child_node.has_value()) continue;
+        auto expected = *child_node;
+        evalH(expected, heuristic);
+        evalChild(node, *child_node, heuristic);
+        ASSERT_EQ(getH(*child_node), getH(expected));
+    }
+}
+
 int main(int argc, char *argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
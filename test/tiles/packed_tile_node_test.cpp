@@ -0,0 +1,281 @@
+#include "packed_tile_node.hpp"
+#include <random>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+class FifteenPuzzlePackedNode: public testing::Test {
+public:
+
+    static int const WIDTH = 4;
+    static int const HEIGHT = 4;
+    static int const N_TILES = WIDTH*HEIGHT;
+    
+    std::array<uint8_t, N_TILES> initial_board = std::array<uint8_t, N_TILES>
+        ({{1, 2, 3, 7, 4, 5, 6, 0, 8, 9, 10, 11, 12, 13, 14, 15}});
+    
+    // initial board
+    /* 1  2  3  7
+       4  5  6  0
+       8  9  10 11
+       12 13 14 15 */
+
+    PackedTileNode<WIDTH, HEIGHT> node =
+        PackedTileNode<WIDTH, HEIGHT>(initial_board);
+};
+
+TEST_F(FifteenPuzzlePackedNode, InitializePackedTileNode) {
+    ASSERT_THAT(node.board,
+                testing::ElementsAre(1, 2, 3, 7,
+                                     4, 5, 6, 0,
+                                     8, 9, 10, 11,
+                                     12, 13, 14, 15));
+    ASSERT_EQ(node.blank_idx, 7);
+}
+
+TEST_F(FifteenPuzzlePackedNode, InvalidBoardThrows) {
+    std::array<uint8_t, N_TILES> invalid_board(
+        {{1, 1, 3, 7, 4, 5, 6, 0, 8, 9, 10, 11, 12, 13, 14, 15}});
+    ASSERT_THROW((PackedTileNode<WIDTH, HEIGHT>(invalid_board)),
+                 std::invalid_argument);
+}
+
+TEST_F(FifteenPuzzlePackedNode, GetChildNodes) {
+    auto child_nodes = getChildNodes(node);
+
+    EXPECT_THAT(child_nodes[UP]->board,
+                testing::ElementsAre(1, 2, 3, 0,
+                                     4, 5, 6, 7,
+                                     8, 9, 10, 11,
+                                     12, 13, 14, 15));
+
+    EXPECT_THAT(child_nodes[DOWN]->board,
+                testing::ElementsAre(1, 2, 3, 7,
+                                     4, 5, 6, 11,
+                                     8, 9, 10, 0,
+                                     12, 13, 14, 15));
+
+    EXPECT_THAT(child_nodes[LEFT]->board,
+                testing::ElementsAre(1, 2, 3, 7,
+                                     4, 5, 0, 6,
+                                     8, 9, 10, 11,
+                                     12, 13, 14, 15));
+            
+    EXPECT_FALSE(child_nodes[RIGHT].has_value());
+}
+
+TEST_F(FifteenPuzzlePackedNode, ChildNodesIncreaseCost) {
+    auto child_nodes = getChildNodes(node);
+    ASSERT_EQ(getG(*child_nodes[DOWN]), getG(node) + 1);
+}
+
+TEST_F(FifteenPuzzlePackedNode, DoNotRegenerateParentNode) {
+    auto child_nodes = getChildNodes(node);
+    auto grandchild_nodes = getChildNodes(*child_nodes[DOWN]);
+    ASSERT_FALSE(grandchild_nodes[UP].has_value());
+}
+
+TEST_F(FifteenPuzzlePackedNode, GetParentNode) {
+    auto child_node = getChildNodes(node)[DOWN];
+    ASSERT_EQ(getParent(*child_node), node);
+}
+
+TEST_F(FifteenPuzzlePackedNode, GoalNode) {
+    EXPECT_FALSE(isGoal(node));
+    auto goal_node = node.moveBlank(UP)->moveBlank(LEFT)->moveBlank(LEFT)
+        ->moveBlank(LEFT);
+    EXPECT_TRUE(isGoal(*goal_node));
+}
+
+TEST_F(FifteenPuzzlePackedNode, SameBoardSameHash) {
+    auto child_node = getChildNodes(node)[DOWN];
+    auto parent_node = getParent(*child_node);
+    auto hasher = std::hash<PackedTileNode<WIDTH, HEIGHT> >();
+    ASSERT_EQ(hasher(node), hasher(*parent_node));
+}
+
+TEST_F(FifteenPuzzlePackedNode, SameBoardSameKey) {
+    auto child_node = getChildNodes(node)[DOWN];
+    auto parent_node = getParent(*child_node);
+    EXPECT_EQ(getKey(node), getKey(*parent_node));
+    EXPECT_NE(getKey(node), getKey(*child_node));
+    EXPECT_NE(getKey(node), 0);
+    ASSERT_EQ(sizeof(getKey(node)), 8);
+}
+
+// hash value cached in node and updated on moves matches the hash value
+// of the board, and of the unpacked node
+TEST_F(FifteenPuzzlePackedNode, IncrementalHash) {
+    auto const & table = ZobristTable<N_TILES>::get();
+    auto moved_node = node;
+    for (int i = 0; i < 100; ++i) {
+        for (auto move : getMoves(moved_node)) {
+            auto child_node = moved_node.moveBlank(move);
+            if (!child_node.has_value()) continue;
+            EXPECT_EQ(getHash(*child_node), table.hash(child_node->board));
+        }
+        auto move = getMoves(moved_node)[i * 7 % N_MOVES];
+        auto prev_move = moved_node.prev_move;
+        auto h_val = moved_node.h_val;
+        auto hash_value = getHash(moved_node);
+        if (!applyMove(moved_node, move)) continue;
+        ASSERT_EQ(getHash(moved_node), table.hash(moved_node.board));
+        undoMove(moved_node, move, prev_move, h_val);
+        ASSERT_EQ(getHash(moved_node), hash_value);
+        applyMove(moved_node, move);
+    }
+    std::array<uint8_t, N_TILES> tiles;
+    std::copy(moved_node.begin(), moved_node.end(), tiles.begin());
+    EXPECT_EQ(getHash(moved_node), getHash(TileNode<WIDTH, HEIGHT>(tiles)));
+    EXPECT_NE(getHash(moved_node), getHash(node));
+}
+
+TEST_F(FifteenPuzzlePackedNode, SeededHash) {
+    using Node = PackedTileNode<WIDTH, HEIGHT>;
+    auto const & table = ZobristTable<N_TILES>::get();
+    Node::seedHash(1);
+    auto hash_value = table.hash(node.board);
+    Node::seedHash(2);
+    EXPECT_NE(table.hash(node.board), hash_value);
+    Node::seedHash(1);
+    EXPECT_EQ(table.hash(node.board), hash_value);
+    // goal node is rehashed
+    EXPECT_EQ(getHash(Node::goal_node), table.hash(Node::goal_node.board));
+    Node::seedHash(std::mt19937_64::default_seed);
+}
+
+// 32 bit hash values are spread over the high bits of the hash function
+TEST_F(FifteenPuzzlePackedNode, ZobristHashSpreadsValues) {
+    using Node = PackedTileNode<WIDTH, HEIGHT>;
+    ZobristHash<Node> hasher;
+    ASSERT_EQ(ZobristHash<Node>::BITS, 32);
+    EXPECT_NE(hasher(node) >> 32, 0);
+    EXPECT_EQ(hasher(node), hasher(Node(initial_board)));
+}
+
+TEST_F(FifteenPuzzlePackedNode, Node16Bytes) {
+    ASSERT_EQ(sizeof(node), 16);
+}
+
+
+class TwentyFourPuzzlePackedNode: public testing::Test {
+public:
+
+    static int const WIDTH = 5;
+    static int const HEIGHT = 5;
+    static int const N_TILES = WIDTH*HEIGHT;
+    
+    std::array<uint8_t, N_TILES> initial_board = std::array<uint8_t, N_TILES>
+        ({{1, 2, 3, 4, 0, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+           15, 16, 17, 18, 19, 20, 21, 22, 23, 24}});
+    
+    // initial board
+    /* 1  2  3  4  0
+       5  6  7  8  9
+       10 11 12 13 14
+       15 16 17 18 19
+       20 21 22 23 24 */
+
+    PackedTileNode<WIDTH, HEIGHT> node =
+        PackedTileNode<WIDTH, HEIGHT>(initial_board);
+};
+
+TEST_F(TwentyFourPuzzlePackedNode, InitializePackedTileNode) {
+    ASSERT_THAT(node.board,
+                testing::ElementsAre(1, 2, 3, 4, 0,
+                                     5, 6, 7, 8, 9,
+                                     10, 11, 12, 13, 14,
+                                     15, 16, 17, 18, 19,
+                                     20, 21, 22, 23, 24));
+    ASSERT_EQ(node.blank_idx, 4);
+}
+
+TEST_F(TwentyFourPuzzlePackedNode, GetChildNodes) {
+    auto child_nodes = getChildNodes(node);
+    
+    EXPECT_FALSE(child_nodes[UP].has_value());
+
+    EXPECT_THAT(child_nodes[DOWN]->board,
+                testing::ElementsAre(1, 2, 3, 4, 9,
+                                     5, 6, 7, 8, 0,
+                                     10, 11, 12, 13, 14,
+                                     15, 16, 17, 18, 19,
+                                     20, 21, 22, 23, 24));
+
+    EXPECT_THAT(child_nodes[LEFT]->board,
+                testing::ElementsAre(1, 2, 3, 0, 4,
+                                     5, 6, 7, 8, 9,
+                                     10, 11, 12, 13, 14,
+                                     15, 16, 17, 18, 19,
+                                     20, 21, 22, 23, 24));
+            
+    EXPECT_FALSE(child_nodes[RIGHT].has_value());
+}
+
+TEST_F(TwentyFourPuzzlePackedNode, TilesAcrossWordHalves) {
+    // tile at index 12 straddles bits 60 - 64
+    auto child_node = node.moveBlank(LEFT)->moveBlank(LEFT)->moveBlank(DOWN)
+        ->moveBlank(DOWN);
+    EXPECT_EQ(child_node->blank_idx, 12);
+    EXPECT_EQ(child_node->board[2], 7);
+    EXPECT_EQ(child_node->board[7], 12);
+    EXPECT_EQ(child_node->board[12], 0);
+    auto parent_node = getParent(*child_node);
+    EXPECT_EQ(parent_node->board[7], 0);
+    EXPECT_EQ(parent_node->board[12], 12);
+}
+
+TEST_F(TwentyFourPuzzlePackedNode, GetParentNode) {
+    auto child_node = getChildNodes(node)[DOWN];
+    ASSERT_EQ(getParent(*child_node), node);
+}
+
+TEST_F(TwentyFourPuzzlePackedNode, GoalNode) {
+    EXPECT_FALSE(isGoal(node));
+    auto goal_node = node.moveBlank(LEFT)->moveBlank(LEFT)->moveBlank(LEFT)
+        ->moveBlank(LEFT);
+    EXPECT_TRUE(isGoal(*goal_node));
+}
+
+TEST_F(TwentyFourPuzzlePackedNode, ApplyAndUndoMove) {
+    auto moved_node = node;
+    for (auto move : getMoves(node)) {
+        auto child_node = node.moveBlank(move);
+        bool applied = applyMove(moved_node, move);
+        ASSERT_EQ(applied, child_node.has_value() &&
+                  node.prev_move != getInverseMove(move));
+        if (!applied) continue;
+        EXPECT_EQ(moved_node, *child_node);
+        EXPECT_EQ(moved_node.blank_idx, child_node->blank_idx);
+        EXPECT_EQ(moved_node.prev_move, move);
+        EXPECT_EQ(getG(moved_node), getG(node) + 1);
+        // reverse move is not applied
+        EXPECT_FALSE(applyMove(moved_node, getInverseMove(move)));
+
+        undoMove(moved_node, move, node.prev_move, node.h_val);
+        EXPECT_EQ(moved_node, node);
+        EXPECT_EQ(moved_node.blank_idx, node.blank_idx);
+        EXPECT_EQ(moved_node.prev_move, node.prev_move);
+        EXPECT_EQ(getG(moved_node), getG(node));
+    }
+}
+
+// hash value is not cached, computed from board
+TEST_F(TwentyFourPuzzlePackedNode, Hash) {
+    auto child_node = node.moveBlank(DOWN);
+    EXPECT_EQ(getHash(*getParent(*child_node)), getHash(node));
+    EXPECT_NE(getHash(*child_node), getHash(node));
+    EXPECT_EQ(getHash(node), getHash(TileNode<WIDTH, HEIGHT>(initial_board)));
+    using Node = PackedTileNode<WIDTH, HEIGHT>;
+    ASSERT_EQ(ZobristHash<Node>::BITS, 64);
+}
+
+TEST_F(TwentyFourPuzzlePackedNode, Node20Bytes) {
+    ASSERT_EQ(sizeof(node), 20);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
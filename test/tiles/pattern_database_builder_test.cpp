@@ -0,0 +1,56 @@
+#include "pattern_database_builder.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+TEST(PatternFrontier, Transitions) {
+    PatternFrontier frontier(100);
+    EXPECT_EQ(frontier.nWords(), 4);
+    EXPECT_EQ(frontier.get(42), PatternFrontier::UNSEEN);
+
+    EXPECT_TRUE(frontier.transition(42, 1u << PatternFrontier::UNSEEN,
+                                    PatternFrontier::NEXT));
+    EXPECT_FALSE(frontier.transition(42, 1u << PatternFrontier::UNSEEN,
+                                     PatternFrontier::NEXT));
+    EXPECT_EQ(frontier.get(42), PatternFrontier::NEXT);
+    EXPECT_EQ(frontier.getCurrentMask(1), 0);
+
+    EXPECT_TRUE(frontier.transition(43, 1u << PatternFrontier::UNSEEN,
+                                    PatternFrontier::CLOSED));
+    EXPECT_EQ(frontier.advance(1), 1);
+    EXPECT_EQ(frontier.get(42), PatternFrontier::CURRENT);
+    EXPECT_EQ(frontier.get(43), PatternFrontier::CLOSED);
+    EXPECT_EQ(frontier.getCurrentMask(1), 1ULL << 2 * (42 - 32));
+}
+
+TEST(PatternDatabaseBuilder, ExactEightPuzzle) {
+    // all tiles in one pattern, table holds exact distances to goal
+    auto table = buildPatternDatabase<3, 3>({1, 2, 3, 4, 5, 6, 7, 8}, 2);
+    EXPECT_EQ(table.size(), nPlacements(9, 8));
+    uint8_t goal_cells[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_EQ(table[rankPlacement(goal_cells, 8, 9)], 0);
+    // tile 1 moved left
+    uint8_t cells[] = {0, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_EQ(table[rankPlacement(cells, 8, 9)], 1);
+    // half of the permutations are unreachable, the rest within 31 moves
+    EXPECT_EQ(std::count(table.begin(), table.end(), 0xFF), table.size() / 2);
+    auto max_depth = 0;
+    for (auto value : table) {
+        if (value != 0xFF) max_depth = std::max<int>(max_depth, value);
+    }
+    EXPECT_EQ(max_depth, 31);
+}
+
+TEST(PatternDatabaseBuilder, ThreadsAgree) {
+    std::vector<uint8_t> tiles = {1, 2, 3, 4};
+    auto single = buildPatternDatabase<4, 4>(tiles, 1);
+    auto multi = buildPatternDatabase<4, 4>(tiles, 4);
+    EXPECT_EQ(single, multi);
+    EXPECT_EQ(std::count(single.begin(), single.end(), 0xFF), 0);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
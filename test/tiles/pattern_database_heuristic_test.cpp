@@ -0,0 +1,211 @@
+#include "pattern_database_heuristic.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "tile_node.hpp"
+#include "random_walk.hpp"
+#include <cstdio>
+#include <random>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+int const WIDTH = 3;
+int const HEIGHT = 3;
+int const N_TILES = WIDTH*HEIGHT;
+
+using Node = TileNode<WIDTH, HEIGHT>;
+
+TEST(PatternDatabase, RankIsPerfectHash) {
+    int const n_placed = 3;
+    auto n_ranks = nPlacements(N_TILES, n_placed);
+    EXPECT_EQ(n_ranks, 9 * 8 * 7);
+    std::vector<bool> seen(n_ranks, false);
+    for (size_t rank = 0; rank < n_ranks; ++rank) {
+        uint8_t cells[n_placed];
+        unrankPlacement(rank, n_placed, N_TILES, cells);
+        EXPECT_NE(cells[0], cells[1]);
+        EXPECT_NE(cells[1], cells[2]);
+        EXPECT_NE(cells[0], cells[2]);
+        auto rerank = rankPlacement(cells, n_placed, N_TILES);
+        ASSERT_EQ(rerank, rank);
+        seen[rerank] = true;
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), n_ranks);
+}
+
+TEST(PatternDatabase, PartitionFromString) {
+    auto partition = getPartitionFromString("1 2 3, 4 5,6");
+    ASSERT_EQ(partition.size(), 3);
+    EXPECT_EQ(partition[0], std::vector<uint8_t>({1, 2, 3}));
+    EXPECT_EQ(partition[1], std::vector<uint8_t>({4, 5}));
+    EXPECT_EQ(partition[2], std::vector<uint8_t>({6}));
+    EXPECT_EQ(getPartitionFromString("78"), fifteenPuzzle78Partition());
+}
+
+TEST(PatternDatabase, OverlappingPartitionThrows) {
+    ASSERT_THROW((PatternDatabaseHeuristic<WIDTH, HEIGHT>({{1, 2}, {2, 3}})),
+                 std::invalid_argument);
+    ASSERT_THROW((PatternDatabaseHeuristic<WIDTH, HEIGHT>({{0, 1}})),
+                 std::invalid_argument);
+}
+
+class PatternDatabaseInitialize : public testing::Test {
+public:
+    // all tiles in one pattern, exact distance to goal
+    PatternDatabaseHeuristic<WIDTH, HEIGHT> exact =
+        PatternDatabaseHeuristic<WIDTH, HEIGHT>({{1, 2, 3, 4, 5, 6, 7, 8}});
+
+    PatternDatabaseHeuristic<WIDTH, HEIGHT> additive =
+        PatternDatabaseHeuristic<WIDTH, HEIGHT>({{1, 2, 3, 4}, {5, 6, 7, 8}});
+
+    ManhattanDistanceHeuristic<WIDTH, HEIGHT> manhattan;
+};
+
+TEST_F(PatternDatabaseInitialize, GoalIsZero) {
+    auto node = Node::goal_node;
+    evalH(node, exact);
+    EXPECT_EQ(getH(node), 0);
+    evalH(node, additive);
+    EXPECT_EQ(getH(node), 0);
+}
+
+TEST_F(PatternDatabaseInitialize, ExactDistance) {
+    // initial board
+    /* 1  2  0
+       3  4  5
+       6  7  8 */
+    auto node = Node({1, 2, 0, 3, 4, 5, 6, 7, 8});
+    evalH(node, exact);
+    EXPECT_EQ(getH(node), 2);
+
+    // optimal solution is 6 moves, manhattan distance is 4
+    /* 0  1  2
+       3  6  5
+       7  4  8 */
+    node = Node({0, 1, 2, 3, 6, 5, 7, 4, 8});
+    evalH(node, manhattan);
+    EXPECT_EQ(getH(node), 4);
+    evalH(node, exact);
+    EXPECT_EQ(getH(node), 6);
+}
+
+TEST_F(PatternDatabaseInitialize, AdditiveIsAdmissibleAndDominatesManhattan) {
+    std::mt19937 rng(0);
+    for (int i = 0; i < 1000; ++i) {
+        auto node = randomWalk<Node>(rng, 40);
+        evalH(node, exact);
+        auto exact_h = getH(node);
+        evalH(node, additive);
+        auto additive_h = getH(node);
+        evalH(node, manhattan);
+        auto manhattan_h = getH(node);
+
+        EXPECT_LE(exact_h, getG(node));
+        EXPECT_EQ(exact_h % 2, getG(node) % 2);
+        EXPECT_LE(additive_h, exact_h);
+        EXPECT_LE(manhattan_h, additive_h);
+    }
+}
+
+TEST_F(PatternDatabaseInitialize, SaveAndLoad) {
+    auto filename = testing::TempDir() + "pattern_database_test.pdb";
+    for (auto const & database : additive.databases) {
+        database.save(filename);
+        auto loaded = PatternDatabase<WIDTH, HEIGHT>::load(filename);
+        EXPECT_EQ(loaded.tiles, database.tiles);
+        ASSERT_EQ(loaded.table_size, database.table_size);
+        EXPECT_TRUE(std::equal(loaded.table.get(),
+                               loaded.table.get() + loaded.table_size,
+                               database.table.get()));
+    }
+    std::remove(filename.c_str());
+    ASSERT_THROW((PatternDatabase<WIDTH, HEIGHT>::load(filename)),
+                 std::runtime_error);
+}
+
+TEST_F(PatternDatabaseInitialize, LoadedHeuristicMatches) {
+    std::vector<std::string> files;
+    std::string filenames;
+    for (size_t i = 0; i < additive.databases.size(); ++i) {
+        files.push_back(testing::TempDir() + "pattern_database_test_" +
+                        std::to_string(i) + ".pdb");
+        additive.databases[i].save(files.back());
+        filenames += (i == 0 ? "" : ",") + files.back();
+    }
+    auto loaded = PatternDatabaseHeuristic<WIDTH, HEIGHT>::load(filenames);
+
+    std::mt19937 rng(0);
+    for (int i = 0; i < 100; ++i) {
+        auto node = randomWalk<Node>(rng, 30);
+        evalH(node, additive);
+        auto additive_h = getH(node);
+        evalH(node, loaded);
+        EXPECT_EQ(getH(node), additive_h);
+    }
+
+    // puzzle dimensions are checked
+    ASSERT_THROW((PatternDatabaseHeuristic<4, 4>::load(filenames)),
+                 std::invalid_argument);
+    for (auto const & file : files) {
+        std::remove(file.c_str());
+    }
+}
+
+TEST_F(PatternDatabaseInitialize, NibbleStorageMatchesByteStorage) {
+    PatternDatabaseHeuristic<WIDTH, HEIGHT, NibbleStorage> nibble(
+        {{1, 2, 3, 4}, {5, 6, 7, 8}});
+    EXPECT_EQ(nibble.databases[0].table_size, (9 * 8 * 7 * 6 + 1) / 2);
+
+    std::mt19937 rng(0);
+    for (int i = 0; i < 1000; ++i) {
+        auto node = randomWalk<Node>(rng, 40);
+        evalH(node, additive);
+        auto additive_h = getH(node);
+        evalH(node, nibble);
+        EXPECT_EQ(getH(node), additive_h);
+    }
+}
+
+TEST_F(PatternDatabaseInitialize, Mod3StorageRecoversValues) {
+    Partition partition = {{1, 2, 3, 4}, {5, 6, 7, 8}};
+    PatternDatabaseHeuristic<WIDTH, HEIGHT, Mod3Storage> mod3(partition);
+    EXPECT_EQ(mod3.databases[0].table_size, 9 * 8 * 7 * 6 / 4);
+
+    // same values as one byte per value, built without blank
+    std::vector< PatternDatabase<WIDTH, HEIGHT> > byte_databases;
+    for (auto const & tiles : partition) {
+        byte_databases.emplace_back(tiles, buildPatternDatabase<WIDTH, HEIGHT>(
+                                        tiles, 1, PatternSpace::WITHOUT_BLANK));
+    }
+    PatternDatabaseHeuristic<WIDTH, HEIGHT> consistent(byte_databases);
+
+    // root by descent, children incrementally from parent
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> dist(0, N_MOVES - 1);
+    auto node = randomWalk<Node>(rng, 30);
+    evalH(node, mod3);
+    for (int i = 0; i < 1000; ++i) {
+        auto expected = node;
+        evalH(expected, consistent);
+        ASSERT_EQ(getH(node), getH(expected));
+
+        auto child_node = node.moveBlank(static_cast<MOVE>(dist(rng)));
+        if (child_node.has_value()) {
+            evalChild(node, *child_node, mod3);
+            node = *child_node;
+        }
+    }
+}
+
+TEST_F(PatternDatabaseInitialize, Mod3StorageNeedsConsistentTable) {
+    // values minimized over blank cells are not consistent
+    std::vector<uint8_t> tiles = {1, 2, 3, 4};
+    ASSERT_THROW((PatternDatabase<WIDTH, HEIGHT, Mod3Storage>(
+                      tiles, buildPatternDatabase<WIDTH, HEIGHT>(
+                          tiles, 1, PatternSpace::WITH_BLANK))),
+                 std::invalid_argument);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -100,6 +100,29 @@ TEST_F(FifteenPuzzleNode, GetParentNode) {
     ASSERT_EQ(getParent(*child_node), node);
 }
 
+TEST_F(FifteenPuzzleNode, ApplyAndUndoMove) {
+    auto moved_node = node;
+    for (auto move : getMoves(node)) {
+        auto child_node = node.moveBlank(move);
+        bool applied = applyMove(moved_node, move);
+        ASSERT_EQ(applied, child_node.has_value() &&
+                  node.prev_move != getInverseMove(move));
+        if (!applied) continue;
+        EXPECT_EQ(moved_node, *child_node);
+        EXPECT_EQ(moved_node.blank_idx, child_node->blank_idx);
+        EXPECT_EQ(moved_node.prev_move, move);
+        EXPECT_EQ(getG(moved_node), getG(node) + 1);
+        // reverse move is not applied
+        EXPECT_FALSE(applyMove(moved_node, getInverseMove(move)));
+
+        undoMove(moved_node, move, node.prev_move, node.h_val);
+        EXPECT_EQ(moved_node, node);
+        EXPECT_EQ(moved_node.blank_idx, node.blank_idx);
+        EXPECT_EQ(moved_node.prev_move, node.prev_move);
+        EXPECT_EQ(getG(moved_node), getG(node));
+    }
+}
+
 TEST_F(FifteenPuzzleNode, Node20Bytes) {
     ASSERT_EQ(sizeof(node), 20);
 }
@@ -0,0 +1,108 @@
+#include "walking_distance_heuristic.hpp"
+#include "linear_conflict_heuristic.hpp"
+#include "manhattan_distance_heuristic.hpp"
+#include "packed_tile_node.hpp"
+#include "pattern_database_heuristic.hpp"
+#include "tile_node.hpp"
+#include "random_walk.hpp"
+#include <random>
+#include <gtest/gtest.h>
+
+using namespace Tiles;
+
+TEST(WalkingDistance, TableKeys) {
+    WalkingDistanceTable<4, 4> table;
+    // known number of configurations of the 15 puzzle row table
+    EXPECT_EQ(table.distances.size(), 24964);
+    EXPECT_EQ((WalkingDistanceTable<3, 3>().distances.size()), 105);
+    // ranks are dense, every rank is reached from the goal
+    for (auto distance : table.distances) {
+        ASSERT_NE(distance, table.UNSEEN);
+    }
+
+    int blank_line;
+    auto counts = table.getCounts(table.getKey({{{2, 2, 0, 0}, {0, 1, 1, 1},
+                                                 {1, 0, 3, 0}, {0, 1, 0, 3}}}, 1),
+                                  blank_line);
+    EXPECT_EQ(blank_line, 1);
+    EXPECT_EQ(counts[1][3], 1);
+    EXPECT_EQ(counts[3][3], 3);
+}
+
+TEST(WalkingDistance, GoalAndKnownBoard) {
+    WalkingDistanceHeuristic<3, 3> heuristic;
+    auto node = TileNode<3, 3>::goal_node;
+    evalH(node, heuristic);
+    EXPECT_EQ(getH(node), 0);
+
+    // initial board
+    /* 0  2  1
+       3  4  5
+       6  7  8 */
+    // row counts are at goal, columns 1 and 2 swap tiles: 2 horizontal moves
+    // cannot do it, one of them has to leave its row and come back
+    node = TileNode<3, 3>({0, 2, 1, 3, 4, 5, 6, 7, 8});
+    evalH(node, heuristic);
+    EXPECT_EQ(getH(node), 4);
+}
+
+TEST(WalkingDistance, AdmissibleAndDominatesManhattan) {
+    WalkingDistanceHeuristic<3, 3> heuristic;
+    ManhattanDistanceHeuristic<3, 3> manhattan;
+    PatternDatabaseHeuristic<3, 3> exact({{1, 2, 3, 4, 5, 6, 7, 8}});
+    std::mt19937 rng(0);
+    for (int i = 0; i < 1000; ++i) {
+        auto node = randomWalk<TileNode<3, 3>>(rng, 40);
+        evalH(node, heuristic);
+        auto walking_distance_h = getH(node);
+        evalH(node, manhattan);
+        auto manhattan_h = getH(node);
+        evalH(node, exact);
+        auto exact_h = getH(node);
+
+        EXPECT_LE(manhattan_h, walking_distance_h);
+        EXPECT_LE(walking_distance_h, exact_h);
+        EXPECT_EQ(walking_distance_h % 2, exact_h % 2);
+    }
+}
+
+template <typename Node, typename Heuristic>
+void checkIncremental(Heuristic const & heuristic) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> dist(0, N_MOVES - 1);
+    auto node = randomWalk<Node>(rng, 50);
+    heuristic.evalH(node);
+    for (int i = 0; i < 2000; ++i) {
+        auto child_node = node.moveBlank(static_cast<MOVE>(dist(rng)));
+        if (!child_node.has_value()) continue;
+        auto expected = *child_node;
+        heuristic.evalH(expected);
+        heuristic.evalChild(node, *child_node);
+        ASSERT_EQ(getH(*child_node), getH(expected));
+        node = *child_node;
+    }
+}
+
+TEST(WalkingDistance, IncrementalMatchesFull) {
+    checkIncremental<TileNode<3, 4>>(WalkingDistanceHeuristic<3, 4>());
+    checkIncremental<PackedTileNode<4, 4>>(WalkingDistanceHeuristic<4, 4>());
+}
+
+TEST(WalkingDistance, TwentyFourPuzzle) {
+    WalkingDistanceHeuristic<5, 5> heuristic;
+    ManhattanDistanceHeuristic<5, 5> manhattan;
+    std::mt19937 rng(0);
+    for (int i = 0; i < 100; ++i) {
+        auto node = randomWalk<PackedTileNode<5, 5>>(rng, 100);
+        evalH(node, heuristic);
+        auto walking_distance_h = getH(node);
+        evalH(node, manhattan);
+        EXPECT_LE(getH(node), walking_distance_h);
+        EXPECT_LE(walking_distance_h, getG(node));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}